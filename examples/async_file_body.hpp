@@ -0,0 +1,247 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_ASYNC_FILE_BODY_H_INCLUDED
+#define BEAST_EXAMPLE_ASYNC_FILE_BODY_H_INCLUDED
+
+#include <beast/http/body_type.hpp>
+#include <beast/http/resume_context.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/logic/tribool.hpp>
+#include <boost/optional.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+/** A pool of threads for performing blocking file I/O.
+
+    Reads are done on these threads so that a slow disk
+    does not stall the threads running network operations.
+*/
+class file_io_pool
+{
+    boost::asio::io_service ios_;
+    boost::optional<boost::asio::io_service::work> work_;
+    std::vector<std::thread> thread_;
+
+public:
+    explicit
+    file_io_pool(std::size_t threads = 1)
+        : work_(ios_)
+    {
+        thread_.reserve(threads);
+        for(std::size_t i = 0; i < threads; ++i)
+            thread_.emplace_back(
+                [&] { ios_.run(); });
+    }
+
+    /// Destructor. Completes all pending work.
+    ~file_io_pool()
+    {
+        work_ = boost::none;
+        for(auto& t : thread_)
+            t.join();
+    }
+
+    /// Run a function on one of the pool threads.
+    template<class Function>
+    void
+    post(Function&& f)
+    {
+        ios_.post(std::forward<Function>(f));
+    }
+};
+
+/** A Body which sends a file, reading ahead on a thread pool.
+
+    Two blocks are used. While one is being sent, the next is read
+    into the other on a @ref file_io_pool thread. When the write
+    operation asks for a block which is not ready yet, the writer
+    suspends it using the resume context, and the pool thread
+    resumes it when the read completes.
+*/
+struct async_file_body
+{
+    struct value_type
+    {
+        /// The path of the file to send.
+        std::string path;
+
+        /// The pool used to read the file.
+        file_io_pool* pool = nullptr;
+
+        value_type() = default;
+
+        value_type(std::string path_, file_io_pool& pool_)
+            : path(std::move(path_))
+            , pool(&pool_)
+        {
+        }
+    };
+
+    class writer
+    {
+        // The size of each block read from the file
+        static std::size_t constexpr block_size = 65536;
+
+        // Shared with the pool thread, which may
+        // still be reading after the writer is gone.
+        struct state
+        {
+            FILE* file = nullptr;
+            std::unique_ptr<char[]> buf;
+            std::mutex m;
+            std::size_t n = 0;
+            error_code ec;
+            bool pending = false;
+            resume_context resume;
+
+            ~state()
+            {
+                if(file)
+                    fclose(file);
+            }
+        };
+
+        value_type const& body_;
+        std::shared_ptr<state> sp_;
+        std::uint64_t size_ = 0;
+        std::uint64_t offset_ = 0;  // bytes handed to the write function
+        std::uint64_t read_ = 0;    // bytes requested from the pool
+        int next_ = 0;              // block holding the next data
+
+    public:
+        writer(writer const&) = delete;
+        writer& operator=(writer const&) = delete;
+
+        template<bool isRequest, class Headers>
+        writer(message<isRequest,
+                async_file_body, Headers> const& m) noexcept
+            : body_(m.body)
+        {
+        }
+
+        void
+        init(error_code& ec) noexcept
+        {
+            if(! body_.pool)
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::invalid_argument);
+                return;
+            }
+            sp_ = std::make_shared<state>();
+            sp_->file = fopen(body_.path.c_str(), "rb");
+            if(! sp_->file)
+            {
+                ec = boost::system::errc::make_error_code(
+                    static_cast<boost::system::errc::errc_t>(errno));
+                return;
+            }
+            // Blocks are read straight into buf
+            setvbuf(sp_->file, nullptr, _IONBF, 0);
+            size_ = boost::filesystem::file_size(body_.path);
+            if(size_ == 0)
+                return;
+            sp_->buf.reset(new(std::nothrow) char[2 * block_size]);
+            if(! sp_->buf)
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::not_enough_memory);
+                return;
+            }
+            read_block(0);
+        }
+
+        std::uint64_t
+        content_length() const noexcept
+        {
+            return size_;
+        }
+
+        template<class WriteFunction>
+        boost::tribool
+        write(resume_context&& rc, error_code& ec,
+            WriteFunction&& wf) noexcept
+        {
+            if(offset_ >= size_)
+                return true;
+            std::size_t n;
+            {
+                std::lock_guard<std::mutex> lock(sp_->m);
+                if(sp_->pending)
+                {
+                    // resumed when the read completes
+                    sp_->resume = std::move(rc);
+                    return boost::indeterminate;
+                }
+                if(sp_->ec)
+                {
+                    ec = sp_->ec;
+                    return true;
+                }
+                n = sp_->n;
+            }
+            auto const p = sp_->buf.get() + next_ * block_size;
+            offset_ += n;
+            next_ = 1 - next_;
+            // The other block was sent before this call
+            if(read_ < size_)
+                read_block(next_);
+            wf(boost::asio::buffer(p, n));
+            return offset_ >= size_;
+        }
+
+    private:
+        void
+        read_block(int i)
+        {
+            std::size_t n = block_size;
+            if(size_ - read_ < n)
+                n = static_cast<std::size_t>(size_ - read_);
+            read_ += n;
+            sp_->pending = true;
+            auto sp = sp_;
+            body_.pool->post(
+                [sp, i, n]
+                {
+                    error_code ec;
+                    if(fread(sp->buf.get() + i * block_size,
+                            1, n, sp->file) != n)
+                        ec = boost::system::errc::make_error_code(
+                            boost::system::errc::io_error);
+                    resume_context rc;
+                    {
+                        std::lock_guard<std::mutex> lock(sp->m);
+                        sp->n = n;
+                        sp->ec = ec;
+                        sp->pending = false;
+                        rc.swap(sp->resume);
+                    }
+                    if(rc)
+                        rc();
+                });
+        }
+    };
+};
+
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,460 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_ENCODED_BODY_H_INCLUDED
+#define BEAST_EXAMPLE_ENCODED_BODY_H_INCLUDED
+
+#include <beast/http/body_type.hpp>
+#include <beast/http/concepts.hpp>
+#include <beast/http/headers.hpp>
+#include <beast/http/resume_context.hpp>
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/logic/tribool.hpp>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <zlib.h>
+
+namespace beast {
+namespace http {
+
+/// A content coding supported by @ref encoded_body.
+enum class content_coding
+{
+    /// The gzip format (rfc1952)
+    gzip,
+
+    /// The zlib format (rfc1950), called "deflate" in HTTP
+    deflate
+};
+
+/** A Body adapter which applies or removes a content coding.
+
+    The writer compresses the output of the wrapped Body's writer,
+    producing the encoded body a block at a time. The reader
+    decompresses the incoming body according to the Content-Encoding
+    field of the message, passing the result to the wrapped Body's
+    reader.
+
+    The caller is responsible for setting the Content-Encoding field
+    of an outgoing message. Since the encoded size is not known in
+    advance, `prepare` uses the chunked transfer coding for HTTP/1.1.
+
+    @tparam Body The Body whose content is encoded.
+*/
+template<class Body>
+struct encoded_body
+{
+    struct value_type
+    {
+        /// The content coding to apply when writing.
+        content_coding coding = content_coding::gzip;
+
+        /// The compression level when writing, from 0 to 9.
+        int level = Z_DEFAULT_COMPRESSION;
+
+        /** The largest decoded size accepted when reading.
+
+            A body which decodes to more octets than this fails with
+            `errc::message_size`. Zero means there is no limit.
+        */
+        std::uint64_t max_decoded_size = 64 * 1024 * 1024;
+
+        /** Holds the content before encoding or after decoding.
+
+            Only the body of this message is used. The readers
+            and writers of the wrapped Body are constructed with it.
+        */
+        message<false, Body, headers> content;
+    };
+
+    class reader;
+
+    class writer;
+};
+
+template<class Body>
+class encoded_body<Body>::writer
+{
+    // The largest encoded block provided in one call
+    static std::size_t constexpr block_size = 65536;
+
+    using is_sync = detail::has_sync_write<typename Body::writer>;
+
+    value_type const& body_;
+    typename Body::writer w_;
+    z_stream zs_;
+    bool zinit_ = false;
+    std::unique_ptr<char[]> out_;
+    std::size_t n_ = 0;
+    bool sent_ = false;
+    bool last_ = false;
+    bool done_ = false;
+    std::vector<boost::asio::const_buffer> in_;
+    std::size_t pos_ = 0;
+
+    // Collects the buffers of the wrapped writer
+    struct collect_function
+    {
+        writer& self;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(ConstBufferSequence const& buffers) const
+        {
+            using boost::asio::buffer_size;
+            for(boost::asio::const_buffer b : buffers)
+                if(buffer_size(b) > 0)
+                    self.in_.push_back(b);
+        }
+    };
+
+public:
+    writer(writer const&) = delete;
+    writer& operator=(writer const&) = delete;
+
+    template<bool isRequest, class Headers>
+    writer(message<isRequest,
+            encoded_body, Headers> const& m) noexcept
+        : body_(m.body)
+        , w_(m.body.content)
+    {
+    }
+
+    ~writer()
+    {
+        if(zinit_)
+            deflateEnd(&zs_);
+    }
+
+    void
+    init(error_code& ec) noexcept
+    {
+        w_.init(ec);
+        if(ec)
+            return;
+        out_.reset(new(std::nothrow) char[block_size]);
+        zs_.zalloc = Z_NULL;
+        zs_.zfree = Z_NULL;
+        zs_.opaque = Z_NULL;
+        // 16 added to the window bits selects the gzip format
+        if(! out_ || deflateInit2(&zs_, body_.level, Z_DEFLATED,
+            body_.coding == content_coding::gzip ? 31 : 15,
+                8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::not_enough_memory);
+            return;
+        }
+        zinit_ = true;
+    }
+
+#if GENERATING_DOCS
+    template<class WriteFunction>
+    boost::tribool
+    write(resume_context&& rc, error_code& ec,
+        WriteFunction&& wf) noexcept;
+#else
+    // Used when the wrapped writer never suspends
+    template<class WriteFunction, class Sync = is_sync>
+    typename std::enable_if<Sync::value, bool>::type
+    write(error_code& ec, WriteFunction&& wf) noexcept
+    {
+        resume_context rc;
+        return bool(write_some(rc, ec, wf));
+    }
+
+    template<class WriteFunction, class Sync = is_sync>
+    typename std::enable_if<! Sync::value, boost::tribool>::type
+    write(resume_context&& rc, error_code& ec,
+        WriteFunction&& wf) noexcept
+    {
+        return write_some(rc, ec, wf);
+    }
+#endif
+
+private:
+    template<class WriteFunction>
+    boost::tribool
+    write_some(resume_context& rc,
+        error_code& ec, WriteFunction& wf)
+    {
+        if(sent_)
+        {
+            // The previous block was written
+            n_ = 0;
+            sent_ = false;
+        }
+        while(n_ < block_size && ! done_)
+        {
+            if(pos_ < in_.size())
+            {
+                using boost::asio::buffer_cast;
+                using boost::asio::buffer_size;
+                auto& b = in_[pos_];
+                std::size_t used;
+                if(! compress(buffer_cast<char const*>(b),
+                        buffer_size(b), Z_NO_FLUSH, used))
+                    return fail(ec);
+                b = b + used;
+                if(buffer_size(b) == 0)
+                    ++pos_;
+                continue;
+            }
+            if(last_)
+            {
+                std::size_t used;
+                if(! compress(nullptr, 0, Z_FINISH, used))
+                    return fail(ec);
+                continue;
+            }
+            // All input was consumed, get more
+            in_.clear();
+            pos_ = 0;
+            boost::tribool const result = call_write(
+                rc, ec, collect_function{*this}, is_sync{});
+            if(ec)
+                return true;
+            if(boost::indeterminate(result))
+                return result;
+            last_ = bool(result);
+        }
+        if(n_ > 0)
+        {
+            sent_ = true;
+            wf(boost::asio::buffer(out_.get(), n_));
+        }
+        return done_;
+    }
+
+    template<class WriteFunction>
+    boost::tribool
+    call_write(resume_context&, error_code& ec,
+        WriteFunction&& wf, std::true_type)
+    {
+        return w_.write(ec, std::forward<WriteFunction>(wf));
+    }
+
+    template<class WriteFunction>
+    boost::tribool
+    call_write(resume_context& rc, error_code& ec,
+        WriteFunction&& wf, std::false_type)
+    {
+        return w_.write(std::move(rc), ec,
+            std::forward<WriteFunction>(wf));
+    }
+
+    // Compress input until it is consumed or the output
+    // is full, returns false on error.
+    bool
+    compress(char const* data, std::size_t size,
+        int flush, std::size_t& used)
+    {
+        // avail_in is only 32 bits
+        if(size > 0x40000000)
+            size = 0x40000000;
+        zs_.next_in = reinterpret_cast<Bytef*>(
+            const_cast<char*>(data));
+        zs_.avail_in = static_cast<uInt>(size);
+        zs_.next_out = reinterpret_cast<Bytef*>(out_.get() + n_);
+        zs_.avail_out = static_cast<uInt>(block_size - n_);
+        auto const ret = deflate(&zs_, flush);
+        n_ = block_size - zs_.avail_out;
+        used = size - zs_.avail_in;
+        if(ret == Z_STREAM_END)
+            done_ = true;
+        return ret == Z_OK ||
+            ret == Z_STREAM_END || ret == Z_BUF_ERROR;
+    }
+
+    bool
+    fail(error_code& ec)
+    {
+        ec = boost::system::errc::make_error_code(
+            boost::system::errc::io_error);
+        return true;
+    }
+};
+
+template<class Body>
+class encoded_body<Body>::reader
+{
+    using has_finish = detail::has_finish<typename Body::reader>;
+
+    value_type& body_;
+    typename Body::reader r_;
+    z_stream zs_;
+    std::uint64_t decoded_ = 0;
+    bool decode_ = false;
+    bool zinit_ = false;
+    bool supported_ = true;
+    bool done_ = false;
+
+public:
+    reader(reader const&) = delete;
+    reader& operator=(reader const&) = delete;
+
+    template<bool isRequest, class Headers>
+    explicit
+    reader(message<isRequest,
+            encoded_body, Headers>& m) noexcept
+        : body_(m.body)
+        , r_(m.body.content)
+    {
+        using beast::detail::ci_equal;
+        auto const coding = m.headers["Content-Encoding"];
+        if(ci_equal(coding, "gzip") || ci_equal(coding, "x-gzip"))
+        {
+            body_.coding = content_coding::gzip;
+            decode_ = true;
+        }
+        else if(ci_equal(coding, "deflate"))
+        {
+            body_.coding = content_coding::deflate;
+            decode_ = true;
+        }
+        else if(! coding.empty() && ! ci_equal(coding, "identity"))
+        {
+            supported_ = false;
+        }
+    }
+
+    ~reader()
+    {
+        if(zinit_)
+            inflateEnd(&zs_);
+    }
+
+    void
+    init(error_code& ec) noexcept
+    {
+        if(! supported_)
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::not_supported);
+            return;
+        }
+        r_.init(ec);
+        if(ec || ! decode_)
+            return;
+        zs_.zalloc = Z_NULL;
+        zs_.zfree = Z_NULL;
+        zs_.opaque = Z_NULL;
+        zs_.next_in = Z_NULL;
+        zs_.avail_in = 0;
+        // 32 added to the window bits detects gzip or zlib
+        if(inflateInit2(&zs_, 15 + 32) != Z_OK)
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::not_enough_memory);
+            return;
+        }
+        zinit_ = true;
+    }
+
+    void
+    write(void const* data,
+        std::size_t size, error_code& ec) noexcept
+    {
+        if(! decode_)
+            return r_.write(data, size, ec);
+        auto p = reinterpret_cast<Bytef*>(
+            const_cast<void*>(data));
+        while(size > 0)
+        {
+            // Octets after the end of the compressed stream
+            if(done_)
+                return fail(ec);
+            // avail_in is only 32 bits
+            auto const n = size > 0x40000000 ?
+                std::size_t{0x40000000} : size;
+            zs_.next_in = p;
+            zs_.avail_in = static_cast<uInt>(n);
+            decompress(ec);
+            if(ec)
+                return;
+            auto const used = n - zs_.avail_in;
+            p += used;
+            size -= used;
+        }
+    }
+
+    void
+    finish(error_code& ec) noexcept
+    {
+        // The compressed stream ended early. An empty
+        // body is accepted, since there is nothing to decode.
+        if(decode_ && ! done_ && zs_.total_in > 0)
+            return fail(ec);
+        finish(ec, has_finish{});
+    }
+
+private:
+    // Decompress input until it is consumed or the
+    // compressed stream ends, passing the output on.
+    void
+    decompress(error_code& ec)
+    {
+        char buf[8192];
+        do
+        {
+            zs_.next_out = reinterpret_cast<Bytef*>(buf);
+            zs_.avail_out = sizeof(buf);
+            auto const ret = inflate(&zs_, Z_NO_FLUSH);
+            auto const n = sizeof(buf) - zs_.avail_out;
+            if(n > 0)
+            {
+                if(body_.max_decoded_size != 0 &&
+                    n > body_.max_decoded_size - decoded_)
+                {
+                    ec = boost::system::errc::make_error_code(
+                        boost::system::errc::message_size);
+                    return;
+                }
+                decoded_ += n;
+                r_.write(buf, n, ec);
+                if(ec)
+                    return;
+            }
+            if(ret == Z_STREAM_END)
+            {
+                done_ = true;
+                return;
+            }
+            if(ret != Z_OK && ret != Z_BUF_ERROR)
+                return fail(ec);
+        }
+        // A full output buffer may leave output pending
+        while(zs_.avail_in > 0 || zs_.avail_out == 0);
+    }
+
+    void
+    finish(error_code& ec, std::true_type)
+    {
+        r_.finish(ec);
+    }
+
+    void
+    finish(error_code&, std::false_type)
+    {
+    }
+
+    void
+    fail(error_code& ec)
+    {
+        ec = boost::system::errc::make_error_code(
+            boost::system::errc::bad_message);
+    }
+};
+
+} // http
+} // beast
+
+#endif
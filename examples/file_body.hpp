@@ -11,24 +11,63 @@
 #include <beast/http/body_type.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/filesystem.hpp>
+#include <cerrno>
 #include <cstdio>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
 
 namespace beast {
 namespace http {
 
 struct file_body
 {
-    using value_type = std::string;
+    /** The file, or range of bytes in the file, to send.
+
+        A range which extends past the end of the file is
+        shortened to end with the file.
+    */
+    struct value_type
+    {
+        /// The path of the file.
+        std::string path;
+
+        /// The offset of the first byte to send.
+        std::uint64_t offset = 0;
+
+        /// The number of bytes to send.
+        std::uint64_t length =
+            (std::numeric_limits<std::uint64_t>::max)();
+
+        value_type() = default;
+
+        value_type(std::string path_)
+            : path(std::move(path_))
+        {
+        }
+
+        value_type(std::string path_,
+                std::uint64_t offset_, std::uint64_t length_)
+            : path(std::move(path_))
+            , offset(offset_)
+            , length(length_)
+        {
+        }
+    };
 
     class writer
     {
+        // The size of each block read from the file
+        static std::size_t constexpr block_size = 65536;
+
         std::uint64_t size_ = 0;
         std::uint64_t offset_ = 0;
-        std::string const& path_;
+        value_type const& body_;
         FILE* file_ = nullptr;
-        char buf_[4096];
-        std::size_t buf_len_;
+        std::unique_ptr<char[]> buf_;
 
     public:
         writer(writer const&) = delete;
@@ -36,7 +75,7 @@ struct file_body
 
         template<bool isRequest, class Headers>
         writer(message<isRequest, file_body, Headers> const& m) noexcept
-            : path_(m.body)
+            : body_(m.body)
         {
         }
 
@@ -49,12 +88,34 @@ struct file_body
         void
         init(error_code& ec) noexcept
         {
-            file_ = fopen(path_.c_str(), "rb");
+            file_ = fopen(body_.path.c_str(), "rb");
             if(! file_)
+            {
+                ec = boost::system::errc::make_error_code(
+                    static_cast<boost::system::errc::errc_t>(errno));
+                return;
+            }
+            // Blocks are read straight into buf_
+            setvbuf(file_, nullptr, _IONBF, 0);
+            auto const size =
+                boost::filesystem::file_size(body_.path);
+            if(body_.offset >= size)
+                return;
+            size_ = size - body_.offset;
+            if(body_.length < size_)
+                size_ = body_.length;
+            if(body_.offset == 0)
+                return;
+            // Seek to the range instead of reading up to it
+#ifdef _MSC_VER
+            if(_fseeki64(file_, static_cast<
+                __int64>(body_.offset), SEEK_SET) != 0)
+#else
+            if(fseeko(file_, static_cast<
+                off_t>(body_.offset), SEEK_SET) != 0)
+#endif
                 ec = boost::system::errc::make_error_code(
                     static_cast<boost::system::errc::errc_t>(errno));
-            else
-                size_ = boost::filesystem::file_size(path_);
         }
 
         std::uint64_t
@@ -63,20 +124,50 @@ struct file_body
             return size_;
         }
 
+        /** Returns the open file.
+
+            This allows an implementation to send the file
+            without reading it through the writer, for example
+            by using `sendfile`. The body starts at @ref offset
+            and has @ref content_length bytes. Only valid after
+            `init`.
+        */
+        FILE*
+        file() const noexcept
+        {
+            return file_;
+        }
+
+        /// Returns the offset in the file of the first byte to send.
+        std::uint64_t
+        offset() const noexcept
+        {
+            return body_.offset;
+        }
+
         template<class WriteFunction>
-        boost::tribool
-        write(resume_context&&, error_code&,
-            WriteFunction&& wf) noexcept
+        bool
+        write(error_code& ec, WriteFunction&& wf) noexcept
         {
-            if(size_ - offset_ < sizeof(buf_))
-                buf_len_ = static_cast<std::size_t>(
-                    size_ - offset_);
-            else
-                buf_len_ = sizeof(buf_);
-            auto const nread = fread(buf_, 1, sizeof(buf_), file_);
-            (void)nread;
-            offset_ += buf_len_;
-            wf(boost::asio::buffer(buf_, buf_len_));
+            if(! buf_)
+                buf_.reset(new(std::nothrow) char[block_size]);
+            if(! buf_)
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::not_enough_memory);
+                return true;
+            }
+            std::size_t n = block_size;
+            if(size_ - offset_ < n)
+                n = static_cast<std::size_t>(size_ - offset_);
+            if(fread(buf_.get(), 1, n, file_) != n)
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::io_error);
+                return true;
+            }
+            offset_ += n;
+            wf(boost::asio::buffer(buf_.get(), n));
             return offset_ >= size_;
         }
     };
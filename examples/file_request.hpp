@@ -0,0 +1,390 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_FILE_REQUEST_H_INCLUDED
+#define BEAST_EXAMPLE_FILE_REQUEST_H_INCLUDED
+
+#include <beast/http/date.hpp>
+#include <beast/http/message.hpp>
+#include <beast/http/rfc7230.hpp>
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+namespace beast {
+namespace http {
+
+// Helpers for conditional and range requests of static files.
+
+/** Returns an entity tag for a version of a file.
+
+    The tag is derived from the modification time and size,
+    which change whenever the file is replaced or modified.
+*/
+inline
+std::string
+make_etag(std::time_t mtime, std::uint64_t size)
+{
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "\"%llx-%llx\"",
+        static_cast<unsigned long long>(mtime),
+        static_cast<unsigned long long>(size));
+    return buf;
+}
+
+/// Returns a time formatted as an HTTP-date (rfc7231 7.1.1.1).
+inline
+std::string
+format_http_date(std::time_t t)
+{
+    char buf[date_size];
+    return std::string(buf, format_date(buf, t));
+}
+
+/** Parse an HTTP-date in the preferred IMF-fixdate format.
+
+    The obsolete formats are not recognized.
+
+    @return `true` if the date was parsed.
+*/
+inline
+bool
+parse_http_date(boost::string_ref s, std::time_t& t)
+{
+    // Sun, 06 Nov 1994 08:49:37 GMT
+    static char const* const months[] = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+        "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+    if(s.size() != 29 || s.substr(3, 2) != ", " ||
+            s.substr(25) != " GMT")
+        return false;
+    auto const num =
+        [&](std::size_t pos, std::size_t len, int& v) -> bool
+        {
+            v = 0;
+            for(auto i = pos; i < pos + len; ++i)
+            {
+                if(s[i] < '0' || s[i] > '9')
+                    return false;
+                v = 10 * v + (s[i] - '0');
+            }
+            return true;
+        };
+    int day, year, hour, min, sec;
+    if(! num(5, 2, day) || ! num(12, 4, year) ||
+            ! num(17, 2, hour) || ! num(20, 2, min) ||
+                ! num(23, 2, sec))
+        return false;
+    int month = 0;
+    while(month < 12 && s.substr(8, 3) != months[month])
+        ++month;
+    if(month == 12 || day < 1 || day > 31 ||
+            hour > 23 || min > 59 || sec > 60)
+        return false;
+    // Days since the epoch of the civil date
+    int const y = month < 2 ? year - 1 : year;
+    int const era = y / 400;
+    int const yoe = y - era * 400;
+    int const doy = (153 * ((month + 10) % 12) + 2) / 5 + day - 1;
+    int const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    long long const days = era * 146097LL + doe - 719468;
+    t = static_cast<std::time_t>(
+        days * 86400 + hour * 3600 + min * 60 + sec);
+    return true;
+}
+
+/// Insert the fields describing the version of a file in a response.
+template<class Headers>
+void
+insert_validators(Headers& headers,
+    std::string const& etag, std::time_t mtime)
+{
+    headers.insert("ETag", etag);
+    headers.insert("Last-Modified", format_http_date(mtime));
+}
+
+namespace detail {
+
+// Returns `true` if a list of entity tags contains the tag,
+// using the weak comparison function (rfc7232 2.3.2).
+inline
+bool
+etag_list_contains(boost::string_ref list, boost::string_ref etag)
+{
+    auto const trim =
+        [](boost::string_ref& s)
+        {
+            while(! s.empty() && (s.front() == ' ' || s.front() == '\t'))
+                s.remove_prefix(1);
+            while(! s.empty() && (s.back() == ' ' || s.back() == '\t'))
+                s.remove_suffix(1);
+        };
+    if(etag.starts_with("W/"))
+        etag.remove_prefix(2);
+    while(! list.empty())
+    {
+        auto const pos = list.find(',');
+        auto item = list.substr(0, pos);
+        list = pos == boost::string_ref::npos ?
+            boost::string_ref{} : list.substr(pos + 1);
+        trim(item);
+        if(item.starts_with("W/"))
+            item.remove_prefix(2);
+        if(item == "*" || item == etag)
+            return true;
+    }
+    return false;
+}
+
+} // detail
+
+/** Returns `true` if a conditional request may be answered with 304.
+
+    If-None-Match takes precedence over If-Modified-Since, which is
+    only used for GET and HEAD requests (rfc7232 6).
+
+    @param req The request.
+
+    @param etag The current entity tag of the file.
+
+    @param mtime The modification time of the file.
+*/
+template<class Body, class Headers>
+bool
+is_not_modified(message<true, Body, Headers> const& req,
+    std::string const& etag, std::time_t mtime)
+{
+    if(req.headers.exists("If-None-Match"))
+        return detail::etag_list_contains(
+            req.headers["If-None-Match"], etag);
+    if(req.verb != verb::get && req.verb != verb::head)
+        return false;
+    std::time_t since;
+    if(! parse_http_date(req.headers["If-Modified-Since"], since))
+        return false;
+    return mtime <= since;
+}
+
+/// The outcome of examining the Range field of a request.
+enum class range_result
+{
+    /// The entire file should be sent
+    full,
+
+    /// The range of bytes should be sent with status 206
+    partial,
+
+    /// The range can't be satisfied, status 416 should be sent
+    unsatisfiable
+};
+
+/** Determine the range of a file to send for a request.
+
+    Only a single byte range is supported. A request for multiple
+    ranges, or with a Range field that does not parse, receives the
+    whole file, as does one whose If-Range no longer matches.
+
+    @param req The request.
+
+    @param etag The current entity tag of the file.
+
+    @param mtime The modification time of the file.
+
+    @param size The size of the file.
+
+    @param first Set to the offset of the first byte to send.
+
+    @param last Set to the offset of the last byte to send.
+*/
+template<class Body, class Headers>
+range_result
+find_range(message<true, Body, Headers> const& req,
+    std::string const& etag, std::time_t mtime,
+        std::uint64_t size, std::uint64_t& first, std::uint64_t& last)
+{
+    if(req.verb != verb::get || ! req.headers.exists("Range"))
+        return range_result::full;
+    if(req.headers.exists("If-Range"))
+    {
+        auto const v = req.headers["If-Range"];
+        std::time_t t;
+        if(v != etag && ! (parse_http_date(v, t) && t == mtime))
+            return range_result::full;
+    }
+    auto s = req.headers["Range"];
+    if(! s.starts_with("bytes="))
+        return range_result::full;
+    s.remove_prefix(6);
+    auto const dash = s.find('-');
+    if(dash == boost::string_ref::npos ||
+            s.find(',') != boost::string_ref::npos)
+        return range_result::full;
+    auto const num =
+        [](boost::string_ref v, std::uint64_t& n) -> bool
+        {
+            if(v.empty() || v.size() > 19)
+                return false;
+            n = 0;
+            for(auto c : v)
+            {
+                if(c < '0' || c > '9')
+                    return false;
+                n = 10 * n + (c - '0');
+            }
+            return true;
+        };
+    auto const lo = s.substr(0, dash);
+    auto const hi = s.substr(dash + 1);
+    if(lo.empty())
+    {
+        // suffix-byte-range-spec
+        std::uint64_t n;
+        if(! num(hi, n))
+            return range_result::full;
+        if(n == 0 || size == 0)
+            return range_result::unsatisfiable;
+        first = n < size ? size - n : 0;
+        last = size - 1;
+        return range_result::partial;
+    }
+    if(! num(lo, first))
+        return range_result::full;
+    if(hi.empty())
+        last = size - 1;
+    else if(! num(hi, last) || last < first)
+        return range_result::full;
+    if(first >= size)
+        return range_result::unsatisfiable;
+    if(last >= size)
+        last = size - 1;
+    return range_result::partial;
+}
+
+/** Returns `true` if a request accepts a content coding.
+
+    The Accept-Encoding field is examined. A coding listed
+    with a quality value of zero is not accepted.
+*/
+template<class Body, class Headers>
+bool
+accepts_encoding(message<true, Body, Headers> const& req,
+    boost::string_ref coding)
+{
+    using beast::detail::ci_equal;
+    // Returns true if the quality value is not zero
+    auto const acceptable =
+        [](param_list const& params) -> bool
+        {
+            for(auto const& param : params)
+                if(ci_equal(param.first, "q"))
+                    return param.second.find_first_not_of(
+                        "0.") != boost::string_ref::npos;
+            return true;
+        };
+    bool any = false;
+    for(auto const& e : ext_list{req.headers["Accept-Encoding"]})
+    {
+        if(ci_equal(e.first, coding))
+            return acceptable(e.second);
+        if(e.first == "*")
+            any = acceptable(e.second);
+    }
+    return any;
+}
+
+/** The representation of a file selected for a request.
+
+    When the client accepts gzip and a precompressed sibling of the
+    file exists with the ".gz" extension, that file is sent instead,
+    with the same Content-Type.
+*/
+struct file_info
+{
+    /// The path of the file to send.
+    std::string path;
+
+    /// The Content-Encoding of the file, or empty.
+    std::string encoding;
+
+    /// `true` if the representation depends on Accept-Encoding.
+    bool vary = false;
+
+    /// The modification time of the file.
+    std::time_t mtime = 0;
+
+    /// The size of the file.
+    std::uint64_t size = 0;
+
+    /// The entity tag of the file.
+    std::string etag;
+};
+
+/** Select the file to send for a request.
+
+    @param req The request.
+
+    @param path The path of the requested file, which must exist.
+
+    @throws boost::filesystem::filesystem_error on failure.
+*/
+template<class Body, class Headers>
+file_info
+find_file(message<true, Body, Headers> const& req,
+    std::string const& path)
+{
+    file_info fi;
+    fi.path = path;
+    auto const gz = path + ".gz";
+    boost::system::error_code ec;
+    if(boost::filesystem::is_regular_file(gz, ec))
+    {
+        fi.vary = true;
+        // A stale sibling is not used
+        if(accepts_encoding(req, "gzip") &&
+            boost::filesystem::last_write_time(gz) >=
+                boost::filesystem::last_write_time(path))
+        {
+            fi.path = gz;
+            fi.encoding = "gzip";
+        }
+    }
+    fi.mtime = boost::filesystem::last_write_time(fi.path);
+    fi.size = boost::filesystem::file_size(fi.path);
+    fi.etag = make_etag(fi.mtime, fi.size);
+    return fi;
+}
+
+/// Insert the fields describing the representation of a file.
+template<class Headers>
+void
+insert_file_fields(Headers& headers, file_info const& fi)
+{
+    if(! fi.encoding.empty())
+        headers.insert("Content-Encoding", fi.encoding);
+    if(fi.vary)
+        headers.insert("Vary", "Accept-Encoding");
+    insert_validators(headers, fi.etag, fi.mtime);
+}
+
+/// Returns the Content-Range field value for a range of a file.
+inline
+std::string
+content_range(std::uint64_t first,
+    std::uint64_t last, std::uint64_t size)
+{
+    return "bytes " + std::to_string(first) + "-" +
+        std::to_string(last) + "/" + std::to_string(size);
+}
+
+} // http
+} // beast
+
+#endif
@@ -8,15 +8,23 @@
 #ifndef BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 #define BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 
+#include "async_file_body.hpp"
+#include "encoded_body.hpp"
 #include "file_body.hpp"
+#include "file_request.hpp"
+#include "mapped_file_body.hpp"
 #include "mime_type.hpp"
+#include "response_cache.hpp"
+#include "sendfile.hpp"
 
 #include <beast/http.hpp>
+#include <beast/core/handler_memory.hpp>
 #include <beast/core/placeholders.hpp>
 #include <beast/core/streambuf.hpp>
 #include <boost/asio.hpp>
 #include <cstddef>
 #include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -28,16 +36,38 @@ namespace http {
 
 class http_async_server
 {
+public:
+    /// How file contents are sent
+    enum class file_mode
+    {
+        /// Read the file in blocks
+        read,
+
+        /// Use sendfile where available, else read
+        sendfile,
+
+        /// Send from a memory mapping shared between connections
+        mmap,
+
+        /// Read ahead on a separate thread pool
+        prefetch
+    };
+
+private:
     using endpoint_type = boost::asio::ip::tcp::endpoint;
     using address_type = boost::asio::ip::address;
     using socket_type = boost::asio::ip::tcp::socket;
 
     using req_type = request<string_body>;
-    using resp_type = response<file_body>;
 
     std::mutex m_;
     bool log_ = true;
+    file_mode mode_;
+    bool compress_;
+    mapping_cache cache_;
+    response_cache responses_;
     boost::asio::io_service ios_;
+    file_io_pool pool_;
     boost::asio::ip::tcp::acceptor acceptor_;
     socket_type sock_;
     std::string root_;
@@ -45,8 +75,13 @@ class http_async_server
 
 public:
     http_async_server(endpoint_type const& ep,
-            std::size_t threads, std::string const& root)
-        : acceptor_(ios_)
+            std::size_t threads, std::string const& root,
+                file_mode mode = file_mode::sendfile,
+                    std::size_t cache_size = 0, bool compress = false)
+        : mode_(mode)
+        , compress_(compress)
+        , responses_(cache_size)
+        , acceptor_(ios_)
         , sock_(ios_)
         , root_(root)
     {
@@ -72,6 +107,13 @@ public:
             t.join();
     }
 
+    /// Returns the cache of small file responses.
+    response_cache const&
+    responses() const
+    {
+        return responses_;
+    }
+
     template<class... Args>
     void
     log(Args const&... args)
@@ -95,18 +137,25 @@ private:
         {
             Stream& s;
             message<isRequest, Body, Headers> m;
+            char buf[512];
+            header_serializer hs;
             Handler h;
+            bool sendfile;
             bool cont;
 
             template<class DeducedHandler>
             data(DeducedHandler&& h_, Stream& s_,
-                    message<isRequest, Body, Headers>&& m_)
+                    message<isRequest, Body, Headers>&& m_,
+                        bool sendfile_)
                 : s(s_)
                 , m(std::move(m_))
+                , hs(buf, sizeof(buf))
                 , h(std::forward<DeducedHandler>(h_))
+                , sendfile(sendfile_)
                 , cont(boost_asio_handler_cont_helpers::
                     is_continuation(h))
             {
+                hs.insert_date(true);
             }
         };
 
@@ -132,12 +181,35 @@ private:
             d.cont = d.cont || again;
             if(! again)
             {
-                beast::http::async_write(d.s, d.m, std::move(*this));
+                send(d.m);
                 return;
             }
             d.h(ec);
         }
 
+        template<bool isRequest_, class Headers_>
+        void
+        send(message<isRequest_, file_body, Headers_> const& m)
+        {
+#if BEAST_EXAMPLE_HAS_SENDFILE
+            if(d_->sendfile)
+            {
+                async_write_sendfile(d_->s, m, std::move(*this));
+                return;
+            }
+#endif
+            beast::http::async_write(
+                d_->s, m, d_->hs, std::move(*this));
+        }
+
+        template<bool isRequest_, class Body_, class Headers_>
+        void
+        send(message<isRequest_, Body_, Headers_> const& m)
+        {
+            beast::http::async_write(
+                d_->s, m, d_->hs, std::move(*this));
+        }
+
         friend
         void* asio_handler_allocate(
             std::size_t size, write_op* op)
@@ -176,16 +248,20 @@ private:
     void
     async_write(Stream& stream, message<
         isRequest, Body, Headers>&& msg,
-            DeducedHandler&& handler)
+            DeducedHandler&& handler, bool sendfile = false)
     {
         write_op<Stream, typename std::decay<DeducedHandler>::type,
             isRequest, Body, Headers>{std::forward<DeducedHandler>(
-                handler), stream, std::move(msg)};
+                handler), stream, std::move(msg), sendfile};
     }
 
     class peer : public std::enable_shared_from_this<peer>
     {
         int id_;
+        // Operations on the connection allocate from here. Only
+        // one is pending at a time, so the same blocks are reused
+        // for every request and no locking is needed.
+        handler_memory mem_;
         streambuf sb_;
         socket_type sock_;
         http_async_server& server_;
@@ -222,8 +298,8 @@ private:
         void do_read()
         {
             async_read(sock_, sb_, req_, strand_.wrap(
-                std::bind(&peer::on_read, shared_from_this(),
-                    asio::placeholders::error)));
+                bind_memory(mem_, std::bind(&peer::on_read,
+                    shared_from_this(), asio::placeholders::error))));
         }
 
         void on_read(error_code const& ec)
@@ -245,23 +321,57 @@ private:
                 res.body = "The file '" + path + "' was not found";
                 prepare(res);
                 async_write(sock_, std::move(res),
-                    std::bind(&peer::on_write, shared_from_this(),
-                        asio::placeholders::error));
+                    bind_memory(mem_, std::bind(&peer::on_write,
+                        shared_from_this(), asio::placeholders::error)));
                 return;
             }
             try
             {
-                resp_type res;
-                res.status = 200;
-                res.reason = "OK";
-                res.version = req_.version;
-                res.headers.insert("Server", "http_async_server");
-                res.headers.insert("Content-Type", mime_type(path));
-                res.body = path;
-                prepare(res);
-                async_write(sock_, std::move(res),
-                    std::bind(&peer::on_write, shared_from_this(),
-                        asio::placeholders::error));
+                auto fi = find_file(req_, path);
+                auto const type = mime_type(path);
+                bool encode = false;
+                if(server_.compress_ && is_compressible(type))
+                {
+                    // Compress on the fly when there is no
+                    // precompressed file the client can use. The
+                    // length isn't known, so chunked encoding is
+                    // required to keep the connection open.
+                    fi.vary = true;
+                    if(fi.encoding.empty() && req_.version >= 11 &&
+                        accepts_encoding(req_, "gzip"))
+                    {
+                        encode = true;
+                        fi.encoding = "gzip";
+                        fi.etag = "W/" + fi.etag.insert(
+                            fi.etag.size() - 1, "-gzip");
+                    }
+                }
+                if(is_not_modified(req_, fi.etag, fi.mtime))
+                    return send_not_modified(fi);
+                if(encode)
+                    return send_encoded(type, fi);
+                std::uint64_t first;
+                std::uint64_t last;
+                switch(find_range(req_,
+                    fi.etag, fi.mtime, fi.size, first, last))
+                {
+                case range_result::partial:
+                    return send_range(type, fi, first, last);
+                case range_result::unsatisfiable:
+                    return send_unsatisfiable(fi.size);
+                case range_result::full:
+                    break;
+                }
+                if(send_cached(type, fi))
+                    return;
+                if(server_.mode_ == file_mode::mmap)
+                    send_file<mapped_file_body>(type, fi,
+                        server_.cache_.get(fi.path));
+                else if(server_.mode_ == file_mode::prefetch)
+                    send_file<async_file_body>(type, fi,
+                        {fi.path, server_.pool_});
+                else
+                    send_file<file_body>(type, fi, fi.path);
             }
             catch(std::exception const& e)
             {
@@ -275,9 +385,152 @@ private:
                     std::string{"An internal error occurred"} + e.what();
                 prepare(res);
                 async_write(sock_, std::move(res),
-                    std::bind(&peer::on_write, shared_from_this(),
-                        asio::placeholders::error));
+                    bind_memory(mem_, std::bind(&peer::on_write,
+                        shared_from_this(), asio::placeholders::error)));
+            }
+        }
+
+        template<class Body>
+        void
+        send_file(std::string const& type, file_info const& fi,
+            typename Body::value_type body)
+        {
+            response<Body> res;
+            res.status = 200;
+            res.reason = "OK";
+            res.version = req_.version;
+            res.headers.insert("Server", "http_async_server");
+            res.headers.insert("Content-Type", type);
+            res.headers.insert("Accept-Ranges", "bytes");
+            insert_file_fields(res.headers, fi);
+            res.body = std::move(body);
+            prepare(res);
+            async_write(sock_, std::move(res),
+                bind_memory(mem_, std::bind(&peer::on_write,
+                    shared_from_this(), asio::placeholders::error)),
+                        server_.mode_ == file_mode::sendfile);
+        }
+
+        // Send the file compressed with gzip as it is read
+        void
+        send_encoded(std::string const& type, file_info const& fi)
+        {
+            response<encoded_body<file_body>> res;
+            res.status = 200;
+            res.reason = "OK";
+            res.version = req_.version;
+            res.headers.insert("Server", "http_async_server");
+            res.headers.insert("Content-Type", type);
+            insert_file_fields(res.headers, fi);
+            res.body.content.body = fi.path;
+            prepare(res);
+            async_write(sock_, std::move(res),
+                bind_memory(mem_, std::bind(&peer::on_write,
+                    shared_from_this(), asio::placeholders::error)));
+        }
+
+        // Send a range of the file, seeking to the first byte
+        void
+        send_range(std::string const& type, file_info const& fi,
+            std::uint64_t first, std::uint64_t last)
+        {
+            response<file_body> res;
+            res.status = 206;
+            res.reason = "Partial Content";
+            res.version = req_.version;
+            res.headers.insert("Server", "http_async_server");
+            res.headers.insert("Content-Type", type);
+            res.headers.insert("Content-Range",
+                content_range(first, last, fi.size));
+            insert_file_fields(res.headers, fi);
+            res.body = {fi.path, first, last - first + 1};
+            prepare(res);
+            async_write(sock_, std::move(res),
+                bind_memory(mem_, std::bind(&peer::on_write,
+                    shared_from_this(), asio::placeholders::error)),
+                        server_.mode_ == file_mode::sendfile);
+        }
+
+        void
+        send_not_modified(file_info const& fi)
+        {
+            response<empty_body> res;
+            res.status = 304;
+            res.reason = "Not Modified";
+            res.version = req_.version;
+            res.headers.insert("Server", "http_async_server");
+            insert_file_fields(res.headers, fi);
+            prepare(res);
+            async_write(sock_, std::move(res),
+                bind_memory(mem_, std::bind(&peer::on_write,
+                    shared_from_this(), asio::placeholders::error)));
+        }
+
+        void
+        send_unsatisfiable(std::uint64_t size)
+        {
+            response<empty_body> res;
+            res.status = 416;
+            res.reason = "Range Not Satisfiable";
+            res.version = req_.version;
+            res.headers.insert("Server", "http_async_server");
+            res.headers.insert("Content-Range",
+                "bytes */" + std::to_string(size));
+            prepare(res);
+            async_write(sock_, std::move(res),
+                bind_memory(mem_, std::bind(&peer::on_write,
+                    shared_from_this(), asio::placeholders::error)));
+        }
+
+        // Send a small file from the response cache,
+        // returns false if the file can't be cached.
+        bool
+        send_cached(std::string const& type, file_info const& fi)
+        {
+            // Cached responses are HTTP/1.1
+            if(req_.version != 11 || ! server_.responses_.accepts(fi.size))
+                return false;
+            auto data = server_.responses_.find(fi.path, fi.mtime, fi.size);
+            if(! data)
+            {
+                data = serialize_file(type, fi);
+                if(! data)
+                    return false;
+                server_.responses_.insert(
+                    fi.path, fi.mtime, fi.size, data);
             }
+            boost::asio::async_write(sock_, boost::asio::buffer(*data),
+                bind_memory(mem_, std::bind(&peer::on_write_cached,
+                    shared_from_this(), data, asio::placeholders::error)));
+            return true;
+        }
+
+        // Returns the complete response for a file, or nullptr
+        response_cache::value_type
+        serialize_file(std::string const& type, file_info const& fi)
+        {
+            response<string_body> res;
+            res.status = 200;
+            res.reason = "OK";
+            res.version = 11;
+            res.headers.insert("Server", "http_async_server");
+            res.headers.insert("Content-Type", type);
+            res.headers.insert("Accept-Ranges", "bytes");
+            insert_file_fields(res.headers, fi);
+            res.body.resize(static_cast<std::size_t>(fi.size));
+            std::ifstream is(fi.path, std::ios::binary);
+            if(! is.read(&res.body[0], res.body.size()) ||
+                    is.peek() != std::ifstream::traits_type::eof())
+                return nullptr;
+            prepare(res);
+            header_serializer hs;
+            hs.serialize(res);
+            auto sp = std::make_shared<std::string>();
+            sp->reserve(hs.size() + res.body.size());
+            sp->append(boost::asio::buffer_cast<char const*>(
+                hs.data()), hs.size());
+            sp->append(res.body);
+            return sp;
         }
 
         void on_write(error_code ec)
@@ -286,6 +539,12 @@ private:
                 fail(ec, "write");
             do_read();
         }
+
+        void on_write_cached(
+            response_cache::value_type const&, error_code ec)
+        {
+            on_write(ec);
+        }
     };
 
     void
@@ -36,7 +36,7 @@ int main(int, char const*[])
             connect(sock, it);
             auto ep = sock.remote_endpoint();
             request<empty_body> req;
-            req.method = "GET";
+            req.verb = verb::get;
             req.url = "/";
             req.version = 11;
             req.headers.insert("Host", host +
@@ -22,7 +22,7 @@ int main()
 
     // Send HTTP request using beast
     beast::http::request<beast::http::empty_body> req;
-    req.method = "GET";
+    req.verb = beast::http::verb::get;
     req.url = "/";
     req.version = 11;
     req.headers.replace("Host", host + ":" + std::to_string(sock.remote_endpoint().port()));
@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the rate at which http_async_server delivers files
+// of various sizes over loopback, for each way of sending files.
+
+#include "http_async_server.hpp"
+
+#include <beast/core/streambuf.hpp>
+#include <beast/http.hpp>
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace beast::http;
+
+// Discards the body of a message, counting the octets.
+struct discard_body
+{
+    using value_type = std::uint64_t;
+
+    class reader
+    {
+        value_type& n_;
+
+    public:
+        template<bool isRequest, class Headers>
+        explicit
+        reader(message<isRequest,
+                discard_body, Headers>& m) noexcept
+            : n_(m.body)
+        {
+            n_ = 0;
+        }
+
+        void
+        init(beast::error_code&) noexcept
+        {
+        }
+
+        void
+        write(void const*, std::size_t size,
+            beast::error_code&) noexcept
+        {
+            n_ += size;
+        }
+
+        void
+        reserve(std::uint64_t) noexcept
+        {
+        }
+
+        boost::asio::mutable_buffers_1
+        prepare(std::size_t n) noexcept
+        {
+            static char buf[65536];
+            return boost::asio::buffer(buf,
+                n < sizeof(buf) ? n : sizeof(buf));
+        }
+
+        void
+        commit(std::size_t n) noexcept
+        {
+            n_ += n;
+        }
+    };
+};
+
+std::string
+file_name(std::size_t mb)
+{
+    return std::to_string(mb) + "mb.bin";
+}
+
+void
+create_file(std::string const& path, std::size_t mb)
+{
+    std::vector<char> block(1024 * 1024);
+    for(std::size_t i = 0; i < block.size(); ++i)
+        block[i] = static_cast<char>('a' + i % 26);
+    std::ofstream os(path, std::ios::binary);
+    for(std::size_t i = 0; i < mb; ++i)
+        os.write(block.data(), block.size());
+}
+
+void
+run(http_async_server::file_mode mode, char const* name,
+    boost::asio::ip::tcp::endpoint const& ep, std::string const& root,
+        std::vector<std::size_t> const& sizes, std::size_t trials)
+{
+    using clock_type = std::chrono::high_resolution_clock;
+    http_async_server server(ep, 1, root, mode);
+    boost::asio::io_service ios;
+    boost::asio::ip::tcp::socket sock(ios);
+    sock.connect(ep);
+    beast::streambuf sb;
+    for(auto mb : sizes)
+    {
+        for(std::size_t trial = 1; trial <= trials; ++trial)
+        {
+            request<empty_body> req;
+            req.verb = verb::get;
+            req.url = "/" + file_name(mb);
+            req.version = 11;
+            req.headers.insert("Host", "localhost");
+            prepare(req);
+            auto const t0 = clock_type::now();
+            write(sock, req);
+            response<discard_body> res;
+            read(sock, sb, res);
+            std::chrono::duration<double> const elapsed =
+                clock_type::now() - t0;
+            if(res.body != mb * 1024 * 1024)
+                std::cerr << "short body: " << res.body << std::endl;
+            std::cout <<
+                name << " " << mb << "MB, trial " << trial << ": " <<
+                static_cast<std::uint64_t>(mb / elapsed.count()) <<
+                " MB/s" << std::endl;
+        }
+    }
+    sock.close();
+}
+
+int main(int ac, char const* av[])
+{
+    namespace fs = boost::filesystem;
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+
+    desc.add_options()
+        ("port,p",      po::value<std::uint16_t>()->default_value(8090),
+                        "Set the first port number for the servers")
+        ("sizes",       po::value<std::vector<std::size_t>>()->multitoken()
+                            ->default_value({1, 16, 256, 1024}, "1 16 256 1024"),
+                        "Set the file sizes to serve, in megabytes")
+        ("trials,t",    po::value<std::size_t>()->default_value(3),
+                        "Set the number of times each file is fetched")
+        ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(ac, av, desc), vm);
+
+    std::uint16_t port = vm["port"].as<std::uint16_t>();
+
+    auto const sizes = vm["sizes"].as<std::vector<std::size_t>>();
+
+    std::size_t trials = vm["trials"].as<std::size_t>();
+
+    auto const root = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(root);
+    for(auto mb : sizes)
+        create_file((root / file_name(mb)).string(), mb);
+
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using address_type = boost::asio::ip::address;
+
+    // Each server gets its own port, in case the
+    // previous one is still in TIME_WAIT.
+    using mode = http_async_server::file_mode;
+    auto const address = address_type::from_string("127.0.0.1");
+    run(mode::read, "read    ", endpoint_type{address, port},
+        root.string(), sizes, trials);
+#if BEAST_EXAMPLE_HAS_SENDFILE
+    run(mode::sendfile, "sendfile", endpoint_type{address,
+        static_cast<std::uint16_t>(port + 1)},
+            root.string(), sizes, trials);
+#endif
+    run(mode::mmap, "mmap    ", endpoint_type{address,
+        static_cast<std::uint16_t>(port + 2)},
+            root.string(), sizes, trials);
+    run(mode::prefetch, "prefetch", endpoint_type{address,
+        static_cast<std::uint16_t>(port + 3)},
+            root.string(), sizes, trials);
+    fs::remove_all(root);
+}
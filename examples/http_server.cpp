@@ -29,6 +29,11 @@ int main(int ac, char const* av[])
         ("threads,n",   po::value<std::size_t>()->default_value(4),
                         "Set the number of threads to use")
         ("sync,s",      "Launch a synchronous server")
+        ("files,f",     po::value<std::string>()->default_value("sendfile"),
+                        "Set how files are sent: read, sendfile, mmap, or prefetch")
+        ("cache,c",     po::value<std::size_t>()->default_value(0),
+                        "Set the size of the small file response cache, in kilobytes")
+        ("gzip,z",      "Compress text files which have no precompressed .gz file")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(ac, av, desc), vm);
@@ -43,6 +48,18 @@ int main(int ac, char const* av[])
 
     bool sync = vm.count("sync") > 0;
 
+    std::size_t cache = vm["cache"].as<std::size_t>();
+
+    bool gzip = vm.count("gzip") > 0;
+
+    auto mode = http_async_server::file_mode::sendfile;
+    if(vm["files"].as<std::string>() == "read")
+        mode = http_async_server::file_mode::read;
+    else if(vm["files"].as<std::string>() == "mmap")
+        mode = http_async_server::file_mode::mmap;
+    else if(vm["files"].as<std::string>() == "prefetch")
+        mode = http_async_server::file_mode::prefetch;
+
     using endpoint_type = boost::asio::ip::tcp::endpoint;
     using address_type = boost::asio::ip::address;
 
@@ -55,7 +72,12 @@ int main(int ac, char const* av[])
     }
     else
     {
-        http_async_server server(ep, threads, root);
+        http_async_server server(
+            ep, threads, root, mode, cache * 1024, gzip);
         beast::test::sig_wait();
+        if(cache > 0)
+            std::cout <<
+                "Cache hits: " << server.responses().hits() <<
+                ", misses: " << server.responses().misses() << std::endl;
     }
 }
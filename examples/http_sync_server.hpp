@@ -9,6 +9,7 @@
 #define BEAST_EXAMPLE_HTTP_SYNC_SERVER_H_INCLUDED
 
 #include "file_body.hpp"
+#include "file_request.hpp"
 #include "mime_type.hpp"
 
 #include <beast/http.hpp>
@@ -151,6 +152,9 @@ private:
     {
         socket_type sock(std::move(sock0));
         streambuf sb;
+        // Reused for every response on the connection
+        header_serializer hs;
+        hs.insert_date(true);
         error_code ec;
         for(;;)
         {
@@ -172,22 +176,80 @@ private:
                 res.headers.insert("Content-Type", "text/html");
                 res.body = "The file '" + path + "' was not found";
                 prepare(res);
-                write(sock, res, ec);
+                write(sock, res, hs, ec);
                 if(ec)
                     break;
                 return;
             }
             try
             {
-                resp_type res;
-                res.status = 200;
-                res.reason = "OK";
-                res.version = req.version;
-                res.headers.insert("Server", "http_sync_server");
-                res.headers.insert("Content-Type", mime_type(path));
-                res.body = path;
-                prepare(res);
-                write(sock, res, ec);
+                auto const fi = find_file(req, path);
+                std::uint64_t first;
+                std::uint64_t last;
+                if(is_not_modified(req, fi.etag, fi.mtime))
+                {
+                    response<empty_body> res;
+                    res.status = 304;
+                    res.reason = "Not Modified";
+                    res.version = req.version;
+                    res.headers.insert("Server", "http_sync_server");
+                    insert_file_fields(res.headers, fi);
+                    prepare(res);
+                    write(sock, res, hs, ec);
+                    if(ec)
+                        break;
+                    continue;
+                }
+                switch(find_range(req,
+                    fi.etag, fi.mtime, fi.size, first, last))
+                {
+                case range_result::partial:
+                {
+                    resp_type res;
+                    res.status = 206;
+                    res.reason = "Partial Content";
+                    res.version = req.version;
+                    res.headers.insert("Server", "http_sync_server");
+                    res.headers.insert("Content-Type", mime_type(path));
+                    res.headers.insert("Content-Range",
+                        content_range(first, last, fi.size));
+                    insert_file_fields(res.headers, fi);
+                    res.body = {fi.path, first, last - first + 1};
+                    prepare(res);
+                    write(sock, res, hs, ec);
+                    break;
+                }
+
+                case range_result::unsatisfiable:
+                {
+                    response<empty_body> res;
+                    res.status = 416;
+                    res.reason = "Range Not Satisfiable";
+                    res.version = req.version;
+                    res.headers.insert("Server", "http_sync_server");
+                    res.headers.insert("Content-Range",
+                        "bytes */" + std::to_string(fi.size));
+                    prepare(res);
+                    write(sock, res, hs, ec);
+                    break;
+                }
+
+                case range_result::full:
+                {
+                    resp_type res;
+                    res.status = 200;
+                    res.reason = "OK";
+                    res.version = req.version;
+                    res.headers.insert("Server", "http_sync_server");
+                    res.headers.insert("Content-Type", mime_type(path));
+                    res.headers.insert("Accept-Ranges", "bytes");
+                    insert_file_fields(res.headers, fi);
+                    res.body = fi.path;
+                    prepare(res);
+                    write(sock, res, hs, ec);
+                    break;
+                }
+                }
                 if(ec)
                     break;
             }
@@ -202,7 +264,7 @@ private:
                 res.body =
                     std::string{"An internal error occurred: "} + e.what();
                 prepare(res);
-                write(sock, res, ec);
+                write(sock, res, hs, ec);
                 if(ec)
                     break;
             }
@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_MAPPED_FILE_BODY_H_INCLUDED
+#define BEAST_EXAMPLE_MAPPED_FILE_BODY_H_INCLUDED
+
+#include <beast/http/body_type.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace beast {
+namespace http {
+
+/** A read-only memory mapping of an entire file.
+
+    If the file is truncated while it is mapped, accessing the
+    missing pages raises `SIGBUS`. Files being served should be
+    replaced rather than modified in place.
+*/
+class mapped_file
+{
+    boost::interprocess::mapped_region region_;
+    std::size_t size_;
+
+public:
+    mapped_file(std::string const& path, std::uint64_t size)
+        : size_(static_cast<std::size_t>(size))
+    {
+        // A zero length mapping is not allowed
+        if(size_ == 0)
+            return;
+        boost::interprocess::file_mapping fm(
+            path.c_str(), boost::interprocess::read_only);
+        region_ = boost::interprocess::mapped_region(
+            fm, boost::interprocess::read_only, 0, size_);
+    }
+
+    void const*
+    data() const
+    {
+        return region_.get_address();
+    }
+
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+};
+
+/** A cache of file mappings shared between connections.
+
+    Mappings are keyed by path, and are replaced when the
+    modification time or size of the file changes. The cache
+    holds weak references: a mapping is released when the last
+    response using it is destroyed, so concurrent requests for
+    the same file share one mapping.
+
+    This object is safe to use from multiple threads.
+*/
+class mapping_cache
+{
+    struct entry
+    {
+        std::time_t mtime = 0;
+        std::uint64_t size = 0;
+        std::weak_ptr<mapped_file const> file;
+    };
+
+    std::mutex m_;
+    std::unordered_map<std::string, entry> map_;
+    std::size_t limit_ = 64;
+
+public:
+    /** Return a mapping of the file at `path`.
+
+        @throws boost::filesystem::filesystem_error or
+        boost::interprocess::interprocess_exception on failure.
+    */
+    std::shared_ptr<mapped_file const>
+    get(std::string const& path)
+    {
+        auto const mtime =
+            boost::filesystem::last_write_time(path);
+        auto const size =
+            boost::filesystem::file_size(path);
+        std::lock_guard<std::mutex> lock(m_);
+        auto& e = map_[path];
+        if(e.mtime == mtime && e.size == size)
+        {
+            auto sp = e.file.lock();
+            if(sp)
+                return sp;
+        }
+        auto sp = std::make_shared<
+            mapped_file const>(path, size);
+        e.mtime = mtime;
+        e.size = size;
+        e.file = sp;
+        prune();
+        return sp;
+    }
+
+private:
+    // Remove entries whose mappings were released
+    void
+    prune()
+    {
+        if(map_.size() < limit_)
+            return;
+        for(auto it = map_.begin(); it != map_.end();)
+        {
+            if(it->second.file.expired())
+                it = map_.erase(it);
+            else
+                ++it;
+        }
+        if(limit_ < 2 * map_.size())
+            limit_ = 2 * map_.size();
+    }
+};
+
+/** A Body which sends a memory mapped file.
+
+    The entire mapping is provided as a single buffer, which
+    is written to the stream directly from the page cache.
+*/
+struct mapped_file_body
+{
+    using value_type = std::shared_ptr<mapped_file const>;
+
+    class writer
+    {
+        value_type const& body_;
+
+    public:
+        writer(writer const&) = delete;
+        writer& operator=(writer const&) = delete;
+
+        template<bool isRequest, class Headers>
+        writer(message<isRequest,
+                mapped_file_body, Headers> const& m) noexcept
+            : body_(m.body)
+        {
+        }
+
+        void
+        init(error_code& ec) noexcept
+        {
+            if(! body_)
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::bad_file_descriptor);
+        }
+
+        std::uint64_t
+        content_length() const noexcept
+        {
+            return body_ ? body_->size() : 0;
+        }
+
+        template<class WriteFunction>
+        bool
+        write(error_code&, WriteFunction&& wf) noexcept
+        {
+            wf(boost::asio::buffer(
+                body_->data(), body_->size()));
+            return true;
+        }
+    };
+};
+
+} // http
+} // beast
+
+#endif
@@ -45,6 +45,18 @@ mime_type(std::string const& path)
     return "application/text";
 }
 
+// Return true if content of the Mime-Type benefits from compression
+inline
+bool
+is_compressible(std::string const& type)
+{
+    return type.compare(0, 5, "text/") == 0 ||
+        type == "application/javascript" ||
+        type == "application/json" ||
+        type == "application/xml" ||
+        type == "image/svg+xml";
+}
+
 } // http
 } // beast
 
@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_RESPONSE_CACHE_H_INCLUDED
+#define BEAST_EXAMPLE_RESPONSE_CACHE_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace beast {
+namespace http {
+
+/** A cache of serialized responses for small static files.
+
+    Each entry holds the complete response, headers followed by the
+    body, ready to be sent with a single write. Entries are keyed by
+    path and are valid only for the modification time and size of
+    the file they were created from.
+
+    When the total size of the entries exceeds the capacity, the
+    least recently used entries are removed.
+
+    This object is safe to use from multiple threads.
+*/
+class response_cache
+{
+public:
+    /// A serialized response.
+    using value_type = std::shared_ptr<std::string const>;
+
+private:
+    struct entry
+    {
+        std::string path;
+        std::time_t mtime;
+        std::uint64_t size;
+        value_type data;
+    };
+
+    using list_type = std::list<entry>;
+
+    std::size_t capacity_;
+    std::uint64_t max_file_size_;
+    std::mutex m_;
+    list_type list_;    // most recently used first
+    std::unordered_map<std::string,
+        list_type::iterator> map_;
+    std::size_t bytes_ = 0;
+    std::atomic<std::size_t> hits_{0};
+    std::atomic<std::size_t> misses_{0};
+
+public:
+    /** Construct the cache.
+
+        @param capacity The largest total size of the cached
+        responses, in bytes. A capacity of zero disables the cache.
+
+        @param max_file_size The size of the largest file
+        whose response is cached.
+    */
+    explicit
+    response_cache(std::size_t capacity,
+            std::uint64_t max_file_size = 65536)
+        : capacity_(capacity)
+        , max_file_size_(max_file_size)
+    {
+    }
+
+    /// Returns `true` if responses for a file of this size are cached.
+    bool
+    accepts(std::uint64_t file_size) const
+    {
+        return capacity_ > 0 && file_size <= max_file_size_;
+    }
+
+    /// Returns the number of lookups which found a response.
+    std::size_t
+    hits() const
+    {
+        return hits_;
+    }
+
+    /// Returns the number of lookups which found no response.
+    std::size_t
+    misses() const
+    {
+        return misses_;
+    }
+
+    /** Return the response for a file, or `nullptr`.
+
+        A response created from a different modification time or
+        size of the file is not returned.
+    */
+    value_type
+    find(std::string const& path,
+        std::time_t mtime, std::uint64_t size)
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        auto const it = map_.find(path);
+        if(it == map_.end() ||
+            it->second->mtime != mtime ||
+                it->second->size != size)
+        {
+            ++misses_;
+            return nullptr;
+        }
+        ++hits_;
+        list_.splice(list_.begin(), list_, it->second);
+        return it->second->data;
+    }
+
+    /** Add the response for a file.
+
+        Any previous response for the path is replaced.
+    */
+    void
+    insert(std::string const& path, std::time_t mtime,
+        std::uint64_t size, value_type data)
+    {
+        if(data->size() > capacity_)
+            return;
+        std::lock_guard<std::mutex> lock(m_);
+        auto const it = map_.find(path);
+        if(it != map_.end())
+        {
+            bytes_ -= it->second->data->size();
+            list_.erase(it->second);
+            map_.erase(it);
+        }
+        bytes_ += data->size();
+        list_.push_front({path, mtime, size, std::move(data)});
+        map_.emplace(path, list_.begin());
+        while(bytes_ > capacity_)
+        {
+            auto& e = list_.back();
+            bytes_ -= e.data->size();
+            map_.erase(e.path);
+            list_.pop_back();
+        }
+    }
+};
+
+} // http
+} // beast
+
+#endif
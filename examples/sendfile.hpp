@@ -0,0 +1,281 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_SENDFILE_H_INCLUDED
+#define BEAST_EXAMPLE_SENDFILE_H_INCLUDED
+
+#include "file_body.hpp"
+
+#include <beast/http.hpp>
+#include <beast/core/async_completion.hpp>
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/handler_alloc.hpp>
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+#if defined(__linux__)
+#define BEAST_EXAMPLE_HAS_SENDFILE 1
+#include <sys/sendfile.h>
+#include <cerrno>
+#else
+#define BEAST_EXAMPLE_HAS_SENDFILE 0
+#endif
+
+#if BEAST_EXAMPLE_HAS_SENDFILE
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+template<class Socket, class Handler,
+    bool isRequest, class Headers>
+class sendfile_op
+{
+    // Bytes sent before yielding to other work on the io_service
+    static std::size_t constexpr max_burst = 4 * 1024 * 1024;
+
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    struct data
+    {
+        Socket& s;
+        message<isRequest, file_body, Headers> const& m;
+        file_body::writer w;
+        char buf[512];
+        header_serializer hs;
+        Handler h;
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+        bool non_blocking = false;
+        bool close;
+        bool cont;
+        int state = 0;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, Socket& s_,
+                message<isRequest, file_body, Headers> const& m_)
+            : s(s_)
+            , m(m_)
+            , w(m_)
+            , hs(buf, sizeof(buf))
+            , h(std::forward<DeducedHandler>(h_))
+            , close(! is_keep_alive(m_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+            hs.insert_date(true);
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+public:
+    sendfile_op(sendfile_op&&) = default;
+    sendfile_op(sendfile_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    sendfile_op(DeducedHandler&& h, Socket& s, Args&&... args)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), s,
+                std::forward<Args>(args)...))
+    {
+        (*this)(error_code{}, 0, false);
+    }
+
+    void
+    operator()(error_code ec,
+        std::size_t bytes_transferred, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, sendfile_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, sendfile_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(sendfile_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, sendfile_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+};
+
+template<class Socket, class Handler,
+    bool isRequest, class Headers>
+void
+sendfile_op<Socket, Handler, isRequest, Headers>::
+operator()(error_code ec, std::size_t, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    std::size_t burst = 0;
+    while(! ec && d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            d.w.init(ec);
+            if(ec)
+            {
+                // call handler
+                d.state = 99;
+                d.s.get_io_service().post(bind_handler(
+                    std::move(*this), ec, 0, false));
+                return;
+            }
+            d.offset = d.w.offset();
+            d.size = d.offset + d.w.content_length();
+            d.hs.serialize(d.m);
+            // write headers
+            d.state = 1;
+            boost::asio::async_write(d.s,
+                d.hs.data(), std::move(*this));
+            return;
+
+        case 1:
+            // sendfile needs the socket in non-blocking
+            // mode, so it returns instead of waiting.
+            d.non_blocking = d.s.native_non_blocking();
+            d.s.native_non_blocking(true, ec);
+            d.state = 2;
+            break;
+
+        case 2:
+        {
+            if(d.offset >= d.size)
+            {
+                d.state = 3;
+                break;
+            }
+            if(burst >= max_burst)
+            {
+                // let other operations run
+                d.s.async_write_some(
+                    boost::asio::null_buffers{}, std::move(*this));
+                return;
+            }
+            std::size_t len = max_burst;
+            if(d.size - d.offset < len)
+                len = static_cast<std::size_t>(d.size - d.offset);
+            auto offset = static_cast<off_t>(d.offset);
+            auto const n = ::sendfile(d.s.native_handle(),
+                fileno(d.w.file()), &offset, len);
+            if(n > 0)
+            {
+                d.offset += n;
+                burst += n;
+                break;
+            }
+            if(n == 0)
+            {
+                // the file was truncated
+                ec = boost::asio::error::eof;
+                break;
+            }
+            if(errno == EINTR)
+                break;
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                // wait until the socket is writable
+                d.s.async_write_some(
+                    boost::asio::null_buffers{}, std::move(*this));
+                return;
+            }
+            ec = error_code{errno,
+                boost::system::system_category()};
+            break;
+        }
+
+        case 3:
+            if(d.close)
+            {
+                // VFALCO TODO Decide on an error code
+                ec = boost::asio::error::eof;
+            }
+            d.state = 99;
+            break;
+        }
+    }
+    if(d.state >= 2)
+    {
+        error_code ignored;
+        d.s.native_non_blocking(d.non_blocking, ignored);
+    }
+    d.h(ec);
+}
+
+} // detail
+
+/** Start an asynchronous operation to send a file body using `sendfile`.
+
+    The headers are written first, after which the contents of the
+    file are copied to the socket by the kernel, without passing
+    through user space. A message using the chunked transfer coding
+    is written using @ref async_write instead.
+
+    The message must remain valid until the completion handler is
+    called. This function is only available when
+    `BEAST_EXAMPLE_HAS_SENDFILE` is `1`.
+
+    @param sock The socket to write to. This must be a stream socket
+    whose `native_handle` is a file descriptor, such as a plain TCP
+    socket. Encrypted streams must use @ref async_write instead.
+
+    @param msg The message to send.
+
+    @param handler The handler to be called when the request
+    completes. The equivalent function signature of the handler
+    must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+*/
+template<class Socket,
+    bool isRequest, class Headers, class WriteHandler>
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+async_write_sendfile(Socket& sock,
+    message<isRequest, file_body, Headers> const& msg,
+        WriteHandler&& handler)
+{
+    beast::async_completion<WriteHandler,
+        void(error_code)> completion(handler);
+    if(token_list{msg.headers["Transfer-Encoding"]}.exists("chunked"))
+        beast::http::async_write(sock, msg, completion.handler);
+    else
+        detail::sendfile_op<Socket, decltype(completion.handler),
+            isRequest, Headers>{completion.handler, sock, msg};
+    return completion.result.get();
+}
+
+} // http
+} // beast
+
+#endif
+
+#endif
@@ -34,7 +34,7 @@ int main()
 
     // Send HTTP request over SSL using Beast
     beast::http::request<beast::http::empty_body> req;
-    req.method = "GET";
+    req.verb = beast::http::verb::get;
     req.url = "/";
     req.version = 11;
     req.headers.insert("Host", host + ":" +
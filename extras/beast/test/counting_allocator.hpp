@@ -0,0 +1,274 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_TEST_COUNTING_ALLOCATOR_HPP
+#define BEAST_TEST_COUNTING_ALLOCATOR_HPP
+
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+namespace test {
+
+/** Statistics for allocations made through an instrumented path.
+
+    A counter is updated by each @ref counting_allocator and each
+    handler returned by @ref bind_counter which refers to it. Call
+    @ref reset before an operation, then inspect the members
+    afterwards, to obtain the figures for that operation alone.
+*/
+class allocation_counter
+{
+public:
+    /// The number of allocations.
+    std::size_t allocations = 0;
+
+    /// The number of deallocations.
+    std::size_t deallocations = 0;
+
+    /// The total number of bytes allocated.
+    std::size_t bytes = 0;
+
+    /// The number of bytes currently allocated.
+    std::size_t live = 0;
+
+    /// The largest value of `live`.
+    std::size_t peak = 0;
+
+    /** Start a new measurement.
+
+        Memory which is still allocated stays counted in `live`,
+        and the peak starts from that amount.
+    */
+    void
+    reset()
+    {
+        allocations = 0;
+        deallocations = 0;
+        bytes = 0;
+        peak = live;
+    }
+
+    /// Record an allocation of `size` bytes.
+    void
+    on_allocate(std::size_t size)
+    {
+        ++allocations;
+        bytes += size;
+        live += size;
+        peak = (std::max)(peak, live);
+    }
+
+    /// Record a deallocation of `size` bytes.
+    void
+    on_deallocate(std::size_t size)
+    {
+        ++deallocations;
+        live -= size;
+    }
+};
+
+/** Returns the counter used by default constructed allocators.
+
+    Containers such as the headers of a @ref http::message are
+    default constructed by the library, so their allocator cannot
+    be given a counter explicitly. Those allocations are recorded
+    here.
+*/
+inline
+allocation_counter&
+default_allocation_counter()
+{
+    static allocation_counter c;
+    return c;
+}
+
+/** An allocator which records its allocations in a counter.
+
+    Memory comes from `std::allocator`. Copies and rebound
+    copies refer to the same counter, and compare equal.
+*/
+template<class T>
+class counting_allocator
+{
+    template<class U>
+    friend class counting_allocator;
+
+    allocation_counter* c_;
+
+public:
+    using value_type = T;
+
+    template<class U>
+    struct rebind
+    {
+        using other = counting_allocator<U>;
+    };
+
+    /// Constructor, using the @ref default_allocation_counter.
+    counting_allocator()
+        : c_(&default_allocation_counter())
+    {
+    }
+
+    /// Constructor.
+    explicit
+    counting_allocator(allocation_counter& c)
+        : c_(&c)
+    {
+    }
+
+    /// Copy constructor.
+    counting_allocator(counting_allocator const&) = default;
+
+    /// Copy constructor, rebinding the value type.
+    template<class U>
+    counting_allocator(counting_allocator<U> const& other)
+        : c_(other.c_)
+    {
+    }
+
+    /// Returns the counter.
+    allocation_counter&
+    counter() const
+    {
+        return *c_;
+    }
+
+    value_type*
+    allocate(std::size_t n)
+    {
+        auto const p = std::allocator<T>{}.allocate(n);
+        c_->on_allocate(n * sizeof(T));
+        return p;
+    }
+
+    void
+    deallocate(value_type* p, std::size_t n)
+    {
+        c_->on_deallocate(n * sizeof(T));
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template<class U>
+    friend
+    bool
+    operator==(counting_allocator const& lhs,
+        counting_allocator<U> const& rhs)
+    {
+        return lhs.c_ == rhs.c_;
+    }
+
+    template<class U>
+    friend
+    bool
+    operator!=(counting_allocator const& lhs,
+        counting_allocator<U> const& rhs)
+    {
+        return ! (lhs == rhs);
+    }
+};
+
+namespace detail {
+
+template<class Handler>
+class counting_handler
+{
+    allocation_counter* c_;
+    Handler h_;
+
+public:
+    using result_type = void;
+
+    counting_handler(counting_handler&&) = default;
+    counting_handler(counting_handler const&) = default;
+
+    template<class DeducedHandler>
+    counting_handler(allocation_counter& c, DeducedHandler&& h)
+        : c_(&c)
+        , h_(std::forward<DeducedHandler>(h))
+    {
+    }
+
+    template<class... Args>
+    void
+    operator()(Args&&... args)
+    {
+        h_(std::forward<Args>(args)...);
+    }
+
+    friend
+    void*
+    asio_handler_allocate(
+        std::size_t size, counting_handler* h)
+    {
+        auto const p = boost_asio_handler_alloc_helpers::
+            allocate(size, h->h_);
+        h->c_->on_allocate(size);
+        return p;
+    }
+
+    friend
+    void
+    asio_handler_deallocate(
+        void* p, std::size_t size, counting_handler* h)
+    {
+        h->c_->on_deallocate(size);
+        boost_asio_handler_alloc_helpers::
+            deallocate(p, size, h->h_);
+    }
+
+    friend
+    bool
+    asio_handler_is_continuation(counting_handler* h)
+    {
+        return boost_asio_handler_cont_helpers::
+            is_continuation(h->h_);
+    }
+
+    template<class F>
+    friend
+    void
+    asio_handler_invoke(F&& f, counting_handler* h)
+    {
+        boost_asio_handler_invoke_helpers::
+            invoke(f, h->h_);
+    }
+};
+
+} // detail
+
+/** Wrap a completion handler so that its allocations are counted.
+
+    Composed operations obtain the memory for their state, and for
+    each intermediate operation, through `asio_handler_allocate` on
+    the completion handler. The returned handler records each such
+    request in `counter`, then forwards it to the original handler,
+    so custom allocation such as @ref bind_memory still applies.
+
+    @param counter The counter to update. It must outlive the handler.
+
+    @param handler The handler to wrap.
+*/
+template<class Handler>
+detail::counting_handler<typename std::decay<Handler>::type>
+bind_counter(allocation_counter& counter, Handler&& handler)
+{
+    return detail::counting_handler<typename std::decay<
+        Handler>::type>(counter, std::forward<Handler>(handler));
+}
+
+} // test
+} // beast
+
+#endif
@@ -11,6 +11,7 @@
 #include <beast/core/async_completion.hpp>
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/error.hpp>
+#include <beast/websocket/teardown.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/io_service.hpp>
 #include <string>
@@ -119,6 +120,24 @@ public:
             error_code{}, boost::asio::buffer_size(buffers)));
         return completion.result.get();
     }
+
+    friend
+    void
+    teardown(websocket::teardown_tag,
+        string_stream&, boost::system::error_code& ec)
+    {
+        ec = {};
+    }
+
+    template<class TeardownHandler>
+    friend
+    void
+    async_teardown(websocket::teardown_tag,
+        string_stream& stream, TeardownHandler&& handler)
+    {
+        stream.get_io_service().post(
+            bind_handler(std::move(handler), error_code{}));
+    }
 };
 
 } // test
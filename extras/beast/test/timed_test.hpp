@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_TEST_TIMED_TEST_HPP
+#define BEAST_TEST_TIMED_TEST_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace beast {
+namespace test {
+
+/// Reports the time of a trial in milliseconds.
+struct in_ms
+{
+    template<class Duration>
+    void
+    operator()(std::ostream& os, Duration elapsed) const
+    {
+        using namespace std::chrono;
+        os << duration_cast<milliseconds>(elapsed).count() << " ms";
+    }
+};
+
+/** Reports the time of a trial, and the rate of items per second.
+
+    @param count The number of items processed in each trial.
+
+    @param what The name of the items, such as "responses".
+*/
+struct per_second
+{
+    std::size_t count;
+    char const* what;
+
+    template<class Duration>
+    void
+    operator()(std::ostream& os, Duration elapsed) const
+    {
+        using namespace std::chrono;
+        auto const ms =
+            duration_cast<milliseconds>(elapsed).count();
+        os << ms << " ms, " <<
+            (count * 1000 / (ms > 0 ? ms : 1)) <<
+                " " << what << "/sec";
+    }
+};
+
+/** Reports the average time of an operation in nanoseconds.
+
+    @param count The number of operations in each trial.
+*/
+struct per_op
+{
+    std::size_t count;
+
+    template<class Duration>
+    void
+    operator()(std::ostream& os, Duration elapsed) const
+    {
+        using namespace std::chrono;
+        os << duration_cast<nanoseconds>(elapsed).count() / count <<
+            " ns/op";
+    }
+};
+
+/** Run a function repeatedly, logging the time of each trial.
+
+    The name is logged first, then one line for each trial,
+    formatted by `report`.
+
+    @param log The stream to log to, usually the suite's log.
+
+    @param repeat The number of trials.
+
+    @param name The name of the test.
+
+    @param f The function to time. It is called once per trial.
+
+    @param report A function invoked as `report(log, elapsed)`
+    to describe each trial. The default reports milliseconds.
+*/
+template<class Function, class Report = in_ms>
+void
+timed_test(std::ostream& log, std::size_t repeat,
+    std::string const& name, Function&& f, Report const& report = {})
+{
+    using clock_type = std::chrono::high_resolution_clock;
+    log << name << std::endl;
+    for(std::size_t trial = 1; trial <= repeat; ++trial)
+    {
+        auto const t0 = clock_type::now();
+        f();
+        auto const elapsed = clock_type::now() - t0;
+        log << "Trial " << trial << ": ";
+        report(log, elapsed);
+        log << std::endl;
+    }
+}
+
+} // test
+} // beast
+
+#endif
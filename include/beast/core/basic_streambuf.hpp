@@ -72,8 +72,10 @@ private:
             "BidirectionalIterator requirements not met");
 
     list_type list_;        // list of allocated buffers
+    list_type free_;        // spent buffers kept for reuse
     iterator out_;          // element that contains out_pos_
     size_type alloc_size_;  // min amount to allocate
+    size_type max_free_ = 0;// max size of free_
     size_type in_size_ = 0; // size of the input sequence
     size_type in_pos_ = 0;  // input offset in list_.front()
     size_type out_pos_ = 0; // output offset in *out_
@@ -239,6 +241,30 @@ public:
         alloc_size_ = n;
     }
 
+    /// Returns the largest number of spent buffers kept for reuse.
+    std::size_t
+    max_free() const
+    {
+        return max_free_;
+    }
+
+    /** Set the largest number of spent buffers kept for reuse.
+
+        Buffers which are emptied by calls to @ref consume, or which
+        are no longer needed by @ref prepare, are normally returned to
+        the allocator. When this is set above zero, up to `n` of them
+        are instead kept, and used by later calls to @ref prepare
+        before allocating. A stream buffer used for every read or
+        write on a long lived connection then stops allocating once
+        it has grown to fit the traffic. The default is zero.
+
+        @note Buffers already kept above the new limit are freed.
+
+        @param n The number of buffers.
+    */
+    void
+    max_free(std::size_t n);
+
     /// Returns the size of the input sequence.
     size_type
     size() const
@@ -307,6 +333,12 @@ private:
     void
     copy_assign(basic_streambuf const& other, std::true_type);
 
+    void
+    recycle(element& e);
+
+    void
+    delete_element(element& e);
+
     void
     delete_list();
 
@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_CIRCULAR_STREAMBUF_HPP
+#define BEAST_CIRCULAR_STREAMBUF_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` with a fixed size ring buffer.
+
+    Bytes are never moved: consuming input makes room for output
+    at the other end of the ring. On Linux, the storage is mapped
+    twice, back to back, so that the input and output sequences
+    are each always a single contiguous buffer, even when they
+    wrap around the end of the ring. Where the mapping is not
+    available, or fails, an ordinary array is used instead, and
+    the sequences are made of at most two buffers.
+
+    The capacity is fixed at construction. When mapped twice, it
+    is rounded up to a multiple of the page size.
+
+    @note Meets the requirements of @b DynamicBuffer.
+*/
+class circular_streambuf
+{
+    char* p_ = nullptr;
+    std::size_t cap_ = 0;
+    std::size_t in_ = 0;    // offset of the input sequence
+    std::size_t size_ = 0;  // size of the input sequence
+    std::size_t out_ = 0;   // size of the output sequence
+    bool mirrored_ = false;
+
+public:
+#if GENERATING_DOCS
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = implementation_defined;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = implementation_defined;
+
+#else
+    class const_buffers_type;
+
+    class mutable_buffers_type;
+
+#endif
+
+    /// Destructor.
+    ~circular_streambuf();
+
+    /** Move constructor.
+
+        After the move, the moved-from object has no storage
+        and a capacity of zero.
+    */
+    circular_streambuf(circular_streambuf&& other);
+
+    /** Move assignment.
+
+        After the move, the moved-from object has no storage
+        and a capacity of zero.
+    */
+    circular_streambuf&
+    operator=(circular_streambuf&& other);
+
+    /// Copy constructor (disallowed).
+    circular_streambuf(circular_streambuf const&) = delete;
+
+    /// Copy assignment (disallowed).
+    circular_streambuf& operator=(circular_streambuf const&) = delete;
+
+    /** Construct a circular stream buffer.
+
+        @param capacity The size of the ring, which must not be zero.
+
+        @param mirror `true` to map the storage twice where the
+        platform supports it. Otherwise an ordinary array is used.
+
+        @throws std::invalid_argument if `capacity` is zero.
+    */
+    explicit
+    circular_streambuf(std::size_t capacity, bool mirror = true);
+
+    /// Returns `true` if the storage is mapped twice.
+    bool
+    mirrored() const
+    {
+        return mirrored_;
+    }
+
+    /// Returns the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /// Returns the permitted maximum sum of the sizes of the input and output sequence.
+    std::size_t
+    max_size() const
+    {
+        return cap_;
+    }
+
+    /// Returns the maximum sum of the sizes of the input sequence and output sequence the buffer can hold without requiring reallocation.
+    std::size_t
+    capacity() const
+    {
+        return cap_;
+    }
+
+    /// Get a list of buffers that represents the input sequence.
+    const_buffers_type
+    data() const;
+
+    /** Get a list of buffers that represents the output sequence, with the given size.
+
+        @throws std::length_error if `size() + n` exceeds `capacity()`.
+
+        @note Buffers representing the input sequence acquired prior to
+        this call remain valid.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /** Move bytes from the output sequence to the input sequence.
+
+        @note Buffers representing the input sequence acquired prior to
+        this call remain valid.
+    */
+    void
+    commit(std::size_t n);
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    // Helper for boost::asio::read_until
+    friend
+    std::size_t
+    read_size_helper(circular_streambuf const& streambuf,
+        std::size_t max_size);
+
+private:
+    bool
+    map(std::size_t capacity);
+
+    void
+    release();
+};
+
+} // beast
+
+#include <beast/core/impl/circular_streambuf.ipp>
+
+#endif
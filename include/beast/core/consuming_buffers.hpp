@@ -29,6 +29,12 @@ namespace beast {
     Ownership of the underlying memory is not transferred, the application
     is still responsible for managing its lifetime.
 
+    Consuming is amortized constant time per buffer. Copies and moves
+    remember how many buffers were consumed instead of measuring it,
+    so they are constant time when the wrapped sequence has random
+    access iterators, and linear in the number of buffers consumed
+    otherwise.
+
     @tparam BufferSequence The buffer sequence to wrap.
 
     @tparam ValueType The type of buffer of the final buffer sequence. This
@@ -53,12 +59,14 @@ class consuming_buffers
 
     BufferSequence bs_;
     iter_type begin_;
+    std::size_t nbegin_ = 0;
     std::size_t skip_ = 0;
 
     template<class Deduced>
     consuming_buffers(Deduced&& other, std::size_t nbegin)
         : bs_(std::forward<Deduced>(other).bs_)
         , begin_(std::next(bs_.begin(), nbegin))
+        , nbegin_(nbegin)
         , skip_(other.skip_)
     {
     }
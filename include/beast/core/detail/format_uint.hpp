@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_FORMAT_UINT_HPP
+#define BEAST_DETAIL_FORMAT_UINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace beast {
+namespace detail {
+
+// The largest number of decimal digits in a std::uint64_t
+static std::size_t constexpr max_uint_digits = 20;
+
+// Returns the number of decimal digits in v
+inline
+std::size_t
+uint_digits(std::uint64_t v)
+{
+    std::size_t n = 1;
+    while(v >= 10)
+    {
+        v /= 10;
+        ++n;
+    }
+    return n;
+}
+
+// Writes the decimal representation of v to dest,
+// which must have room for uint_digits(v) chars.
+// Returns one past the last char written.
+inline
+char*
+format_uint(char* dest, std::uint64_t v)
+{
+    auto const end = dest + uint_digits(v);
+    auto p = end;
+    do
+    {
+        *--p = static_cast<char>('0' + v % 10);
+        v /= 10;
+    }
+    while(v != 0);
+    return end;
+}
+
+// `true` for integers written as decimal numbers. This
+// excludes bool and the character types, which
+// boost::lexical_cast does not format as numbers.
+template<class T>
+struct is_formattable_integer : std::integral_constant<bool,
+    std::is_integral<T>::value &&
+    ! std::is_same<T, bool>::value &&
+    ! std::is_same<T, char>::value &&
+    ! std::is_same<T, signed char>::value &&
+    ! std::is_same<T, unsigned char>::value &&
+    ! std::is_same<T, wchar_t>::value &&
+    ! std::is_same<T, char16_t>::value &&
+    ! std::is_same<T, char32_t>::value>
+{
+};
+
+// Writes the decimal representation of v to dest, which
+// must have room for max_uint_digits + 1 chars. Negative
+// values are preceded by a minus sign.
+// Returns one past the last char written.
+template<class T>
+typename std::enable_if<
+    std::is_unsigned<T>::value, char*>::type
+format_int(char* dest, T v)
+{
+    return format_uint(dest, v);
+}
+
+template<class T>
+typename std::enable_if<
+    std::is_signed<T>::value, char*>::type
+format_int(char* dest, T v)
+{
+    if(v >= 0)
+        return format_uint(dest,
+            static_cast<std::uint64_t>(v));
+    // Negate in unsigned arithmetic so the minimum value works
+    *dest++ = '-';
+    return format_uint(dest,
+        0 - static_cast<std::uint64_t>(v));
+}
+
+} // detail
+} // beast
+
+#endif
@@ -9,8 +9,12 @@
 #define BEAST_DETAIL_WRITE_DYNABUF_HPP
 
 #include <beast/core/buffer_concepts.hpp>
+#include <beast/core/static_string.hpp>
+#include <beast/core/detail/format_uint.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
 #include <utility>
 
 namespace beast {
@@ -110,6 +114,41 @@ write_dynabuf(DynamicBuffer& dynabuf, const char (&s)[N])
 
 template<class DynamicBuffer, class T>
 typename std::enable_if<
+    is_formattable_integer<T>::value>::type
+write_dynabuf(DynamicBuffer& dynabuf, T const& t)
+{
+    using boost::asio::buffer_copy;
+    char buf[max_uint_digits + 1];
+    auto const n = static_cast<std::size_t>(
+        format_int(buf, t) - buf);
+    dynabuf.commit(buffer_copy(
+        dynabuf.prepare(n), boost::asio::buffer(buf, n)));
+}
+
+template<class DynamicBuffer>
+void
+write_dynabuf(DynamicBuffer& dynabuf, boost::string_ref const& s)
+{
+    using boost::asio::buffer_copy;
+    dynabuf.commit(buffer_copy(
+        dynabuf.prepare(s.size()),
+            boost::asio::buffer(s.data(), s.size())));
+}
+
+template<class DynamicBuffer, std::size_t N, class Traits>
+void
+write_dynabuf(DynamicBuffer& dynabuf,
+    static_string<N, char, Traits> const& s)
+{
+    using boost::asio::buffer_copy;
+    dynabuf.commit(buffer_copy(
+        dynabuf.prepare(s.size()),
+            boost::asio::buffer(s.data(), s.size())));
+}
+
+template<class DynamicBuffer, class T>
+typename std::enable_if<
+    ! is_formattable_integer<T>::value &&
     ! is_string_literal<T>::value &&
     ! is_ConstBufferSequence<T>::value &&
     ! is_BufferConvertible<T>::value &&
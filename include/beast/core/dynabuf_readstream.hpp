@@ -95,10 +95,17 @@ class dynabuf_readstream
     template<class Buffers, class Handler>
     class read_some_op;
 
+    template<class Handler>
+    class fill_op;
+
     DynamicBuffer sb_;
     std::size_t capacity_ = 0;
+    std::size_t read_size_ = 0;
     Stream next_layer_;
 
+    void
+    adapt(std::size_t bytes_transferred);
+
 public:
     /// The type of the internal buffer
     using dynabuf_type = DynamicBuffer;
@@ -192,12 +199,30 @@ public:
         return sb_;
     }
 
+    /** Returns the buffered input without consuming it.
+
+        The returned buffers refer to the internal buffer, no
+        copy is made. They are invalidated by any subsequent
+        read or modification of the internal buffer.
+    */
+    typename DynamicBuffer::const_buffers_type
+    buffered_data() const
+    {
+        return sb_.data();
+    }
+
     /** Set the maximum buffer size.
 
         This changes the maximum size of the internal buffer used
         to hold read data. No bytes are discarded by this call. If
         the buffer size is set to zero, no more data will be buffered.
 
+        The amount actually read ahead adapts to the stream: it
+        starts small, doubles each time a read fills it, up to
+        this maximum, and halves when reads return much less.
+        Reads into caller buffers at least as large as the current
+        read-ahead bypass the internal buffer.
+
         Thread safety:
             The caller is responsible for making sure the call is
             made from the same implicit or explicit strand.
@@ -208,11 +233,71 @@ public:
         than the amount of data in the buffer, no bytes are discarded.
     */
     void
-    capacity(std::size_t size)
+    capacity(std::size_t size);
+
+    /// Returns the number of bytes the next buffered read will request.
+    std::size_t
+    read_size() const
     {
-        capacity_ = size;
+        return read_size_;
     }
 
+    /** Read until the internal buffer holds at least `n` bytes.
+
+        Data already buffered counts towards `n`. Reads request at
+        least the current read-ahead size, so more than `n` bytes
+        may be buffered on return. Nothing is consumed, the data
+        is available through @ref buffered_data.
+
+        @param n The number of bytes to buffer.
+
+        @throws system_error Thrown on failure.
+    */
+    void
+    fill(std::size_t n);
+
+    /** Read until the internal buffer holds at least `n` bytes.
+
+        Data already buffered counts towards `n`. Reads request at
+        least the current read-ahead size, so more than `n` bytes
+        may be buffered on return. Nothing is consumed, the data
+        is available through @ref buffered_data.
+
+        @param n The number of bytes to buffer.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    fill(std::size_t n, error_code& ec);
+
+    /** Start reading until the internal buffer holds at least `n` bytes.
+
+        Data already buffered counts towards `n`. Reads request at
+        least the current read-ahead size, so more than `n` bytes
+        may be buffered on completion. Nothing is consumed, the data
+        is available through @ref buffered_data.
+
+        @param n The number of bytes to buffer.
+
+        @param handler The handler to be called when the request
+        completes. Copies will be made of the handler as required.
+        The equivalent function signature of the handler must be:
+        @code void handler(
+            error_code const& error // result of operation
+        ); @endcode
+        Regardless of whether the asynchronous operation completes
+        immediately or not, the handler will not be invoked from within
+        this function. Invocation of the handler will be performed in a
+        manner equivalent to using `boost::asio::io_service::post`.
+    */
+    template<class ReadHandler>
+#if GENERATING_DOCS
+    void_or_deduced
+#else
+    typename async_completion<ReadHandler, void(error_code)>::result_type
+#endif
+    async_fill(std::size_t n, ReadHandler&& handler);
+
     /// Write the given data to the stream. Returns the number of bytes written.
     /// Throws an exception on failure.
     template<class ConstBufferSequence>
@@ -0,0 +1,260 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_FLAT_STREAMBUF_HPP
+#define BEAST_FLAT_STREAMBUF_HPP
+
+#include <beast/core/detail/empty_base_optimization.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` that uses a single contiguous buffer.
+
+    The input sequence is always one contiguous range of bytes, so
+    that algorithms such as parsers see all the buffered data at
+    once, without iterating segments or copying it.
+
+    When the output sequence does not fit after the input sequence,
+    the input sequence is first moved to the front of the buffer if
+    that makes enough room. Otherwise a buffer of at least twice the
+    size is allocated, up to the limit given at construction.
+
+    @note Meets the requirements of @b DynamicBuffer.
+
+    @tparam Allocator The allocator to use for managing memory.
+*/
+template<class Allocator>
+class basic_flat_streambuf
+#if ! GENERATING_DOCS
+    : private detail::empty_base_optimization<
+        typename std::allocator_traits<Allocator>::
+            template rebind_alloc<char>>
+#endif
+{
+public:
+#if GENERATING_DOCS
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+#else
+    using allocator_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<char>;
+#endif
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    char* p_ = nullptr;
+    char* in_ = nullptr;
+    char* out_ = nullptr;
+    char* last_ = nullptr;
+    char* end_ = nullptr;
+    std::size_t max_;
+
+public:
+#if GENERATING_DOCS
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = implementation_defined;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = implementation_defined;
+
+#else
+    using const_buffers_type = boost::asio::const_buffers_1;
+
+    using mutable_buffers_type = boost::asio::mutable_buffers_1;
+
+#endif
+
+    /// Destructor.
+    ~basic_flat_streambuf();
+
+    /** Move constructor.
+
+        The new object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+    */
+    basic_flat_streambuf(basic_flat_streambuf&&);
+
+    /** Move assignment.
+
+        This object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+    */
+    basic_flat_streambuf&
+    operator=(basic_flat_streambuf&&);
+
+    /** Copy constructor.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    basic_flat_streambuf(basic_flat_streambuf const&);
+
+    /** Copy assignment.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    basic_flat_streambuf&
+    operator=(basic_flat_streambuf const&);
+
+    /** Construct a flat stream buffer.
+
+        No memory is allocated until the first call to
+        @ref prepare or @ref reserve.
+
+        @param limit The largest size of the buffer. Calls to
+        @ref prepare which would exceed it throw an exception.
+
+        @param alloc The allocator to use. If this parameter is
+        unspecified, a default constructed allocator will be used.
+    */
+    explicit
+    basic_flat_streambuf(
+        std::size_t limit = (std::numeric_limits<std::size_t>::max)(),
+            Allocator const& alloc = allocator_type{});
+
+    /// Returns a copy of the associated allocator.
+    allocator_type
+    get_allocator() const
+    {
+        return this->member();
+    }
+
+    /// Returns the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return out_ - in_;
+    }
+
+    /// Returns the permitted maximum sum of the sizes of the input and output sequence.
+    std::size_t
+    max_size() const
+    {
+        return max_;
+    }
+
+    /// Returns the maximum sum of the sizes of the input sequence and output sequence the buffer can hold without requiring reallocation.
+    std::size_t
+    capacity() const
+    {
+        return end_ - p_;
+    }
+
+    /// Get a list of buffers that represents the input sequence.
+    const_buffers_type
+    data() const
+    {
+        return const_buffers_type(in_, size());
+    }
+
+    /** Get a list of buffers that represents the output sequence, with the given size.
+
+        @throws std::length_error if `size() + n` exceeds `max_size()`.
+
+        @note All previous buffers sequences obtained from
+        calls to @ref data or @ref prepare are invalidated.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /// Move bytes from the output sequence to the input sequence.
+    void
+    commit(std::size_t n)
+    {
+        out_ += (std::min<std::size_t>)(n, last_ - out_);
+    }
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    /** Reserve storage for the input and output sequences.
+
+        Upon return, @ref capacity is at least `n`.
+
+        @throws std::length_error if `n` exceeds `max_size()`.
+    */
+    void
+    reserve(std::size_t n);
+
+    /** Reallocate the buffer to fit the input sequence.
+
+        The output sequence is discarded.
+    */
+    void
+    shrink_to_fit();
+
+    // Helper for boost::asio::read_until
+    template<class OtherAllocator>
+    friend
+    std::size_t
+    read_size_helper(basic_flat_streambuf<
+        OtherAllocator> const& streambuf, std::size_t max_size);
+
+private:
+    void
+    move_from(basic_flat_streambuf& other);
+
+    void
+    move_assign(basic_flat_streambuf& other, std::false_type);
+
+    void
+    move_assign(basic_flat_streambuf& other, std::true_type);
+
+    void
+    copy_assign(basic_flat_streambuf const& other, std::false_type);
+
+    void
+    copy_assign(basic_flat_streambuf const& other, std::true_type);
+
+    void
+    reallocate(std::size_t capacity);
+
+    void
+    deallocate();
+};
+
+/** Format output to a @ref basic_flat_streambuf.
+
+    @param streambuf The @ref basic_flat_streambuf to write to.
+
+    @param t The object to write.
+
+    @return A reference to the @ref basic_flat_streambuf.
+*/
+template<class Allocator, class T>
+basic_flat_streambuf<Allocator>&
+operator<<(basic_flat_streambuf<Allocator>& streambuf, T const& t);
+
+/** A @b `DynamicBuffer` that uses a single contiguous buffer.
+
+    @note Meets the requirements of @b `DynamicBuffer`.
+*/
+using flat_streambuf =
+    basic_flat_streambuf<std::allocator<char>>;
+
+} // beast
+
+#include <beast/core/impl/flat_streambuf.ipp>
+
+#endif
@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HANDLER_MEMORY_HPP
+#define BEAST_HANDLER_MEMORY_HPP
+
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+
+/** Memory which is recycled between the operations of one connection.
+
+    Composed operations allocate their state, and the state of each
+    intermediate operation, through the completion handler using
+    `asio_handler_allocate`. Unless the handler customizes it, every
+    allocation goes to the global heap. A handler wrapped with
+    @ref bind_memory allocates from this object instead.
+
+    Released blocks are kept on a list and handed out again to later
+    allocations of the same size or smaller. Once the blocks needed
+    by the largest operation have been allocated, further operations
+    on the connection do not use the heap at all.
+
+    @note Objects of this type are not thread safe. All handlers which
+    use the same object must be invoked with no concurrency, for example
+    through the same strand or from an `io_service` with one thread.
+    The object must outlive every handler bound to it.
+*/
+class handler_memory
+{
+    union block;
+
+    struct header
+    {
+        block* next;
+        std::size_t size;
+    };
+
+    union block
+    {
+        header h;
+        std::max_align_t align;
+    };
+
+    block* free_ = nullptr;
+    std::size_t n_ = 0;
+    std::size_t max_;
+
+public:
+    /// Destructor.
+    ~handler_memory()
+    {
+        while(free_)
+        {
+            auto const next = free_->h.next;
+            ::operator delete(free_);
+            free_ = next;
+        }
+    }
+
+    /// Copy constructor (disallowed).
+    handler_memory(handler_memory const&) = delete;
+
+    /// Copy assignment (disallowed).
+    handler_memory& operator=(handler_memory const&) = delete;
+
+    /** Constructor.
+
+        No memory is allocated until the first call to @ref allocate.
+
+        @param limit The largest number of released blocks to keep.
+    */
+    explicit
+    handler_memory(std::size_t limit = 8)
+        : max_(limit)
+    {
+    }
+
+    /// Returns the number of released blocks kept for reuse.
+    std::size_t
+    size() const
+    {
+        return n_;
+    }
+
+    /// Allocate memory, reusing a released block if one fits.
+    void*
+    allocate(std::size_t size)
+    {
+        for(auto pp = &free_; *pp; pp = &(*pp)->h.next)
+        {
+            auto const b = *pp;
+            if(b->h.size >= size)
+            {
+                *pp = b->h.next;
+                --n_;
+                return b + 1;
+            }
+        }
+        auto const b = static_cast<block*>(
+            ::operator new(sizeof(block) + size));
+        b->h.size = size;
+        return b + 1;
+    }
+
+    /// Release memory obtained from @ref allocate.
+    void
+    deallocate(void* p, std::size_t)
+    {
+        auto const b = static_cast<block*>(p) - 1;
+        if(n_ >= max_)
+        {
+            ::operator delete(b);
+            return;
+        }
+        b->h.next = free_;
+        free_ = b;
+        ++n_;
+    }
+};
+
+namespace detail {
+
+template<class Handler>
+class memory_handler
+{
+    handler_memory* m_;
+    Handler h_;
+
+public:
+    using result_type = void;
+
+    memory_handler(memory_handler&&) = default;
+    memory_handler(memory_handler const&) = default;
+
+    template<class DeducedHandler>
+    memory_handler(handler_memory& m, DeducedHandler&& h)
+        : m_(&m)
+        , h_(std::forward<DeducedHandler>(h))
+    {
+    }
+
+    template<class... Args>
+    void
+    operator()(Args&&... args)
+    {
+        h_(std::forward<Args>(args)...);
+    }
+
+    friend
+    void*
+    asio_handler_allocate(
+        std::size_t size, memory_handler* h)
+    {
+        return h->m_->allocate(size);
+    }
+
+    friend
+    void
+    asio_handler_deallocate(
+        void* p, std::size_t size, memory_handler* h)
+    {
+        h->m_->deallocate(p, size);
+    }
+
+    friend
+    bool
+    asio_handler_is_continuation(memory_handler* h)
+    {
+        return boost_asio_handler_cont_helpers::
+            is_continuation(h->h_);
+    }
+
+    template<class F>
+    friend
+    void
+    asio_handler_invoke(F&& f, memory_handler* h)
+    {
+        boost_asio_handler_invoke_helpers::
+            invoke(f, h->h_);
+    }
+};
+
+} // detail
+
+/** Wrap a completion handler so that it allocates from a @ref handler_memory.
+
+    The returned handler forwards its arguments to the original handler,
+    and provides the same `io_service` execution guarantees, but the
+    memory for the operations it is passed to comes from `memory`.
+
+    Example:
+    @code
+    async_read(sock_, sb_, req_, bind_memory(mem_,
+        std::bind(&peer::on_read, shared_from_this(),
+            asio::placeholders::error)));
+    @endcode
+
+    When the handler is also wrapped by a strand, call `bind_memory`
+    on the handler first and pass the result to `strand::wrap`, so
+    that the strand allocates from the same memory.
+
+    @param memory The memory to use. It must outlive the handler.
+
+    @param handler The handler to wrap.
+*/
+template<class Handler>
+#if GENERATING_DOCS
+implementation_defined
+#else
+detail::memory_handler<typename std::decay<Handler>::type>
+#endif
+bind_memory(handler_memory& memory, Handler&& handler)
+{
+    return detail::memory_handler<typename std::decay<
+        Handler>::type>(memory, std::forward<Handler>(handler));
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HANDLER_PTR_HPP
+#define BEAST_HANDLER_PTR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+
+/** A smart pointer to the state of a composed operation.
+
+    The pointer owns an object of type `T`, and the final completion
+    handler of the operation. Both are stored in one block of memory,
+    obtained using the handler's `asio_handler_allocate`. The object
+    is constructed with a reference to the stored handler followed by
+    the remaining constructor arguments, so that it can query the
+    handler, for example with `asio_handler_is_continuation`.
+
+    Moving the pointer transfers ownership without touching any count.
+    Composed operations move themselves from one intermediate operation
+    to the next, so in practice there is exactly one owner. Copies are
+    permitted because handlers must be @b CopyConstructible; a copy
+    shares ownership through a reference count.
+
+    The object is destroyed and its memory released when one of the
+    following happens:
+
+    @li The function @ref invoke is called. The memory is released
+    before the handler is called, so that the handler may start a
+    new operation which reuses it.
+
+    @li The function @ref release_handler is called.
+
+    @li The last pointer owning the object is destroyed.
+
+    @tparam T The type of object managed.
+
+    @tparam Handler The type of the final completion handler.
+*/
+template<class T, class Handler>
+class handler_ptr
+{
+    struct P
+    {
+        std::atomic<std::size_t> n;
+        Handler handler;
+        bool live = true;
+        typename std::aligned_storage<
+            sizeof(T), alignof(T)>::type t;
+
+        template<class DeducedHandler>
+        explicit
+        P(DeducedHandler&& h)
+            : n(1)
+            , handler(std::forward<DeducedHandler>(h))
+        {
+        }
+
+        T&
+        get()
+        {
+            return *reinterpret_cast<T*>(&t);
+        }
+    };
+
+    P* p_;
+
+public:
+    /// The type of the managed object.
+    using element_type = T;
+
+    /// The type of the completion handler.
+    using handler_type = Handler;
+
+    /// Copy assignment (disallowed).
+    handler_ptr& operator=(handler_ptr const&) = delete;
+
+    /** Destructor.
+
+        If this is the last owner, the managed object is
+        destroyed and its memory released.
+    */
+    ~handler_ptr();
+
+    /** Move constructor.
+
+        After the move, `other` owns nothing.
+    */
+    handler_ptr(handler_ptr&& other)
+        : p_(other.p_)
+    {
+        other.p_ = nullptr;
+    }
+
+    /// Copy constructor. The managed object is shared.
+    handler_ptr(handler_ptr const& other)
+        : p_(other.p_)
+    {
+        if(p_)
+            ++p_->n;
+    }
+
+    // Keeps the constructor below from hijacking
+    // copies of non-const pointers.
+    handler_ptr(handler_ptr& other)
+        : handler_ptr(
+            static_cast<handler_ptr const&>(other))
+    {
+    }
+
+    /** Construct the managed object.
+
+        The handler is moved or copied into the new block of
+        memory, then `T` is constructed from a reference to the
+        stored handler followed by `args`.
+
+        @param handler The final completion handler.
+
+        @param args Additional arguments for the constructor of `T`.
+    */
+    template<class DeducedHandler, class... Args>
+    explicit
+    handler_ptr(DeducedHandler&& handler, Args&&... args);
+
+    /// Returns a pointer to the managed object, or `nullptr`.
+    T*
+    get() const
+    {
+        return p_ && p_->live ? &p_->get() : nullptr;
+    }
+
+    /// Returns a reference to the managed object.
+    T&
+    operator*() const
+    {
+        return p_->get();
+    }
+
+    /// Returns a pointer to the managed object.
+    T*
+    operator->() const
+    {
+        return &p_->get();
+    }
+
+    /** Returns a reference to the completion handler.
+
+        The pointer must own an object.
+    */
+    Handler&
+    handler() const
+    {
+        return p_->handler;
+    }
+
+    /** Release ownership, returning the completion handler.
+
+        The managed object is destroyed and, if this was the
+        only owner, its memory is released.
+    */
+    Handler
+    release_handler();
+
+    /** Invoke the completion handler.
+
+        The managed object is destroyed and, if this was the only
+        owner, its memory released, before the handler is called
+        with the given arguments. After the call, this pointer
+        owns nothing.
+    */
+    template<class... Args>
+    void
+    invoke(Args&&... args);
+};
+
+} // beast
+
+#include <beast/core/impl/handler_ptr.ipp>
+
+#endif
@@ -404,6 +404,7 @@ basic_streambuf(basic_streambuf&& other)
     : detail::empty_base_optimization<allocator_type>(
         std::move(other.member()))
     , alloc_size_(other.alloc_size_)
+    , max_free_(other.max_free_)
     , in_size_(other.in_size_)
     , in_pos_(other.in_pos_)
     , out_pos_(other.out_pos_)
@@ -412,6 +413,7 @@ basic_streambuf(basic_streambuf&& other)
     auto const at_end =
         other.out_ == other.list_.end();
     list_ = std::move(other.list_);
+    free_ = std::move(other.free_);
     out_ = at_end ? list_.end() : other.out_;
     other.in_size_ = 0;
     other.out_ = other.list_.end();
@@ -443,6 +445,7 @@ basic_streambuf<Allocator>::operator=(
     // VFALCO If any memory allocated we could use it first?
     clear();
     alloc_size_ = other.alloc_size_;
+    max_free_ = other.max_free_;
     move_assign(other, std::integral_constant<bool,
         alloc_traits::propagate_on_container_move_assignment::value>{});
     return *this;
@@ -454,6 +457,7 @@ basic_streambuf(basic_streambuf const& other)
     : basic_streambuf(other.alloc_size_,
         alloc_traits::select_on_container_copy_construction(other.member()))
 {
+    max_free_ = other.max_free_;
     commit(boost::asio::buffer_copy(prepare(other.size()), other.data()));
 }
 
@@ -463,6 +467,7 @@ basic_streambuf(basic_streambuf const& other,
         allocator_type const& alloc)
     : basic_streambuf(other.alloc_size_, alloc)
 {
+    max_free_ = other.max_free_;
     commit(boost::asio::buffer_copy(prepare(other.size()), other.data()));
 }
 
@@ -597,11 +602,21 @@ basic_streambuf<Allocator>::prepare(size_type n) ->
     }
     while(n > 0)
     {
-        auto const size = std::max(alloc_size_, n);
-        auto& e = *reinterpret_cast<element*>(
-            alloc_traits::allocate(this->member(),
-                sizeof(element) + size));
-        alloc_traits::construct(this->member(), &e, size);
+        element* p;
+        if(! free_.empty())
+        {
+            p = &free_.front();
+            free_.pop_front();
+        }
+        else
+        {
+            auto const size = std::max(alloc_size_, n);
+            p = reinterpret_cast<element*>(
+                alloc_traits::allocate(this->member(),
+                    sizeof(element) + size));
+            alloc_traits::construct(this->member(), p, size);
+        }
+        auto& e = *p;
         list_.push_back(e);
         if(out_ == list_.end())
             out_ = list_.iterator_to(e);
@@ -621,10 +636,7 @@ basic_streambuf<Allocator>::prepare(size_type n) ->
     {
         auto& e = *it++;
         reuse.erase(list_.iterator_to(e));
-        auto const len = e.size() + sizeof(e);
-        alloc_traits::destroy(this->member(), &e);
-        alloc_traits::deallocate(this->member(),
-            reinterpret_cast<std::uint8_t*>(&e), len);
+        recycle(e);
     }
     return mutable_buffers_type(*this);
 }
@@ -693,10 +705,7 @@ basic_streambuf<Allocator>::consume(size_type n)
             in_pos_ = 0;
             auto& e = list_.front();
             list_.erase(list_.iterator_to(e));
-            auto const len = e.size() + sizeof(e);
-            alloc_traits::destroy(this->member(), &e);
-            alloc_traits::deallocate(this->member(),
-                reinterpret_cast<std::uint8_t*>(&e), len);
+            recycle(e);
             debug_check();
         }
         else
@@ -737,6 +746,7 @@ clear()
 {
     delete_list();
     list_.clear();
+    free_.clear();
     out_ = list_.begin();
     in_size_ = 0;
     in_pos_ = 0;
@@ -768,6 +778,7 @@ move_assign(basic_streambuf& other, std::true_type)
     auto const at_end =
         other.out_ == other.list_.end();
     list_ = std::move(other.list_);
+    free_ = std::move(other.free_);
     out_ = at_end ? list_.end() : other.out_;
 
     in_size_ = other.in_size_;
@@ -800,18 +811,50 @@ copy_assign(basic_streambuf const& other, std::true_type)
 
 template<class Allocator>
 void
-basic_streambuf<Allocator>::delete_list()
+basic_streambuf<Allocator>::
+max_free(std::size_t n)
 {
-    for(auto iter = list_.begin(); iter != list_.end();)
+    max_free_ = n;
+    while(free_.size() > max_free_)
     {
-        auto& e = *iter++;
-        auto const n = e.size() + sizeof(e);
-        alloc_traits::destroy(this->member(), &e);
-        alloc_traits::deallocate(this->member(),
-            reinterpret_cast<std::uint8_t*>(&e), n);
+        auto& e = free_.back();
+        free_.pop_back();
+        delete_element(e);
     }
 }
 
+template<class Allocator>
+void
+basic_streambuf<Allocator>::
+recycle(element& e)
+{
+    if(free_.size() < max_free_)
+        free_.push_back(e);
+    else
+        delete_element(e);
+}
+
+template<class Allocator>
+void
+basic_streambuf<Allocator>::
+delete_element(element& e)
+{
+    auto const n = e.size() + sizeof(e);
+    alloc_traits::destroy(this->member(), &e);
+    alloc_traits::deallocate(this->member(),
+        reinterpret_cast<std::uint8_t*>(&e), n);
+}
+
+template<class Allocator>
+void
+basic_streambuf<Allocator>::delete_list()
+{
+    for(auto iter = list_.begin(); iter != list_.end();)
+        delete_element(*iter++);
+    for(auto iter = free_.begin(); iter != free_.end();)
+        delete_element(*iter++);
+}
+
 template<class Allocator>
 void
 basic_streambuf<Allocator>::debug_check() const
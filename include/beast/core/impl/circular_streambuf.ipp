@@ -0,0 +1,289 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_CIRCULAR_STREAMBUF_IPP
+#define BEAST_IMPL_CIRCULAR_STREAMBUF_IPP
+
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace beast {
+
+class circular_streambuf::const_buffers_type
+{
+    boost::asio::const_buffer b_[2];
+    std::size_t n_;
+
+public:
+    using value_type = boost::asio::const_buffer;
+
+    using const_iterator = value_type const*;
+
+    const_buffers_type() = delete;
+    const_buffers_type(
+        const_buffers_type const&) = default;
+    const_buffers_type& operator=(
+        const_buffers_type const&) = default;
+
+    const_iterator
+    begin() const
+    {
+        return b_;
+    }
+
+    const_iterator
+    end() const
+    {
+        return b_ + n_;
+    }
+
+private:
+    friend class circular_streambuf;
+
+    const_buffers_type(char const* p0, std::size_t n0,
+            char const* p1, std::size_t n1)
+        : n_(n1 > 0 ? 2 : 1)
+    {
+        b_[0] = value_type{p0, n0};
+        b_[1] = value_type{p1, n1};
+    }
+};
+
+class circular_streambuf::mutable_buffers_type
+{
+    boost::asio::mutable_buffer b_[2];
+    std::size_t n_;
+
+public:
+    using value_type = boost::asio::mutable_buffer;
+
+    using const_iterator = value_type const*;
+
+    mutable_buffers_type() = delete;
+    mutable_buffers_type(
+        mutable_buffers_type const&) = default;
+    mutable_buffers_type& operator=(
+        mutable_buffers_type const&) = default;
+
+    const_iterator
+    begin() const
+    {
+        return b_;
+    }
+
+    const_iterator
+    end() const
+    {
+        return b_ + n_;
+    }
+
+private:
+    friend class circular_streambuf;
+
+    mutable_buffers_type(char* p0, std::size_t n0,
+            char* p1, std::size_t n1)
+        : n_(n1 > 0 ? 2 : 1)
+    {
+        b_[0] = value_type{p0, n0};
+        b_[1] = value_type{p1, n1};
+    }
+};
+
+inline
+circular_streambuf::~circular_streambuf()
+{
+    release();
+}
+
+inline
+circular_streambuf::
+circular_streambuf(circular_streambuf&& other)
+    : p_(other.p_)
+    , cap_(other.cap_)
+    , in_(other.in_)
+    , size_(other.size_)
+    , out_(other.out_)
+    , mirrored_(other.mirrored_)
+{
+    other.p_ = nullptr;
+    other.cap_ = 0;
+    other.in_ = 0;
+    other.size_ = 0;
+    other.out_ = 0;
+    other.mirrored_ = false;
+}
+
+inline
+auto
+circular_streambuf::
+operator=(circular_streambuf&& other) ->
+    circular_streambuf&
+{
+    if(this == &other)
+        return *this;
+    release();
+    p_ = other.p_;
+    cap_ = other.cap_;
+    in_ = other.in_;
+    size_ = other.size_;
+    out_ = other.out_;
+    mirrored_ = other.mirrored_;
+    other.p_ = nullptr;
+    other.cap_ = 0;
+    other.in_ = 0;
+    other.size_ = 0;
+    other.out_ = 0;
+    other.mirrored_ = false;
+    return *this;
+}
+
+inline
+circular_streambuf::
+circular_streambuf(std::size_t capacity, bool mirror)
+{
+    if(capacity == 0)
+        throw std::invalid_argument(
+            "circular_streambuf: capacity == 0");
+    if(mirror && map(capacity))
+        return;
+    p_ = new char[capacity];
+    cap_ = capacity;
+}
+
+inline
+auto
+circular_streambuf::data() const ->
+    const_buffers_type
+{
+    if(mirrored_)
+        return const_buffers_type(p_ + in_, size_, nullptr, 0);
+    auto const n = (std::min)(size_, cap_ - in_);
+    return const_buffers_type(p_ + in_, n, p_, size_ - n);
+}
+
+inline
+auto
+circular_streambuf::prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n > cap_ - size_)
+        throw std::length_error(
+            "circular_streambuf overflow");
+    out_ = n;
+    auto const pos = (in_ + size_) % cap_;
+    if(mirrored_)
+        return mutable_buffers_type(p_ + pos, n, nullptr, 0);
+    auto const n0 = (std::min)(n, cap_ - pos);
+    return mutable_buffers_type(p_ + pos, n0, p_, n - n0);
+}
+
+inline
+void
+circular_streambuf::commit(std::size_t n)
+{
+    size_ += (std::min)(n, out_);
+    out_ = 0;
+}
+
+inline
+void
+circular_streambuf::consume(std::size_t n)
+{
+    if(n < size_)
+    {
+        in_ = (in_ + n) % cap_;
+        size_ -= n;
+        return;
+    }
+    if(out_ == 0)
+        // Start over, so the unmirrored
+        // output sequence stays in one piece
+        in_ = 0;
+    else
+        in_ = (in_ + size_) % cap_;
+    size_ = 0;
+}
+
+inline
+bool
+circular_streambuf::map(std::size_t capacity)
+{
+#if defined(__linux__) && defined(SYS_memfd_create)
+    auto const page = static_cast<std::size_t>(
+        ::sysconf(_SC_PAGESIZE));
+    auto const size = (capacity + page - 1) / page * page;
+    int const fd = static_cast<int>(::syscall(
+        SYS_memfd_create, "circular_streambuf", 1u)); // MFD_CLOEXEC
+    if(fd == -1)
+        return false;
+    void* p = MAP_FAILED;
+    if(::ftruncate(fd, static_cast<off_t>(size)) == 0)
+        // Reserve both halves, then map the file over each
+        p = ::mmap(nullptr, 2 * size, PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p != MAP_FAILED)
+    {
+        auto const base = static_cast<char*>(p);
+        if(::mmap(base, size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+            ::mmap(base + size, size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+        {
+            ::munmap(base, 2 * size);
+            p = MAP_FAILED;
+        }
+    }
+    ::close(fd);
+    if(p == MAP_FAILED)
+        return false;
+    p_ = static_cast<char*>(p);
+    cap_ = size;
+    mirrored_ = true;
+    return true;
+#else
+    (void)capacity;
+    return false;
+#endif
+}
+
+inline
+void
+circular_streambuf::release()
+{
+    if(! p_)
+        return;
+#if defined(__linux__) && defined(SYS_memfd_create)
+    if(mirrored_)
+    {
+        ::munmap(p_, 2 * cap_);
+        return;
+    }
+#endif
+    delete[] p_;
+}
+
+inline
+std::size_t
+read_size_helper(circular_streambuf const& streambuf,
+    std::size_t max_size)
+{
+    // When full, ask for one byte so that
+    // prepare reports the overflow.
+    return (std::min)(max_size, (std::max<std::size_t>)(
+        streambuf.capacity() - streambuf.size(), 1));
+}
+
+} // beast
+
+#endif
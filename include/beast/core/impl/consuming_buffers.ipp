@@ -108,18 +108,14 @@ private:
 template<class BufferSequence, class ValueType>
 consuming_buffers<BufferSequence, ValueType>::
 consuming_buffers(consuming_buffers&& other)
-    : consuming_buffers(std::move(other),
-        std::distance<iter_type>(
-            other.bs_.begin(), other.begin_))
+    : consuming_buffers(std::move(other), other.nbegin_)
 {
 }
 
 template<class BufferSequence, class ValueType>
 consuming_buffers<BufferSequence, ValueType>::
 consuming_buffers(consuming_buffers const& other)
-    : consuming_buffers(other,
-        std::distance<iter_type>(
-            other.bs_.begin(), other.begin_))
+    : consuming_buffers(other, other.nbegin_)
 {
 }
 
@@ -129,10 +125,10 @@ consuming_buffers<BufferSequence, ValueType>::
 operator=(consuming_buffers&& other) ->
     consuming_buffers&
 {
-    auto const nbegin = std::distance<iter_type>(
-        other.bs_.begin(), other.begin_);
+    auto const nbegin = other.nbegin_;
     bs_ = std::move(other.bs_);
     begin_ = std::next(bs_.begin(), nbegin);
+    nbegin_ = nbegin;
     skip_ = other.skip_;
     return *this;
 }
@@ -143,10 +139,10 @@ consuming_buffers<BufferSequence, ValueType>::
 operator=(consuming_buffers const& other) ->
     consuming_buffers&
 {
-    auto const nbegin = std::distance<iter_type>(
-        other.bs_.begin(), other.begin_);
+    auto const nbegin = other.nbegin_;
     bs_ = other.bs_;
     begin_ = std::next(bs_.begin(), nbegin);
+    nbegin_ = nbegin;
     skip_ = other.skip_;
     return *this;
 }
@@ -182,7 +178,7 @@ void
 consuming_buffers<BufferSequence, ValueType>::consume(std::size_t n)
 {
     using boost::asio::buffer_size;
-    for(;n > 0 && begin_ != bs_.end(); ++begin_)
+    for(;n > 0 && begin_ != bs_.end(); ++begin_, ++nbegin_)
     {
         auto const len =
             buffer_size(*begin_) - skip_;
@@ -11,7 +11,8 @@
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/error.hpp>
 #include <beast/core/handler_concepts.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
+#include <algorithm>
 
 namespace beast {
 
@@ -20,28 +21,21 @@ template<class MutableBufferSequence, class Handler>
 class dynabuf_readstream<
     Stream, DynamicBuffer>::read_some_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
-
     struct data
     {
         dynabuf_readstream& srs;
         MutableBufferSequence bs;
-        Handler h;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_,
-            dynabuf_readstream& srs_,
+        data(Handler& h, dynabuf_readstream& srs_,
                 MutableBufferSequence const& bs_)
             : srs(srs_)
             , bs(bs_)
-            , h(std::forward<DeducedHandler>(h_))
         {
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     read_some_op(read_some_op&&) = default;
@@ -50,9 +44,8 @@ public:
     template<class DeducedHandler, class... Args>
     read_some_op(DeducedHandler&& h,
             dynabuf_readstream& srs, Args&&... args)
-        : d_(std::allocate_shared<data>(alloc_type{h},
-            std::forward<DeducedHandler>(h), srs,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            srs, std::forward<Args>(args)...)
     {
         (*this)(error_code{}, 0);
     }
@@ -66,7 +59,7 @@ public:
         std::size_t size, read_some_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -74,14 +67,14 @@ public:
         void* p, std::size_t size, read_some_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
     bool asio_handler_is_continuation(read_some_op* op)
     {
         return boost_asio_handler_cont_helpers::
-            is_continuation(op->d_->h);
+            is_continuation(op->d_.handler());
     }
 
     template<class Function>
@@ -89,7 +82,7 @@ public:
     void asio_handler_invoke(Function&& f, read_some_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -108,8 +101,8 @@ read_some_op<MutableBufferSequence, Handler>::operator()(
         case 0:
             if(d.srs.sb_.size() == 0)
             {
-                d.state =
-                    d.srs.capacity_ > 0 ? 2 : 1;
+                d.state = boost::asio::buffer_size(d.bs) >=
+                    d.srs.read_size_ ? 1 : 2;
                 break;
             }
             d.state = 4;
@@ -128,7 +121,7 @@ read_some_op<MutableBufferSequence, Handler>::operator()(
             // read
             d.state = 3;
             d.srs.next_layer_.async_read_some(
-                d.srs.sb_.prepare(d.srs.capacity_),
+                d.srs.sb_.prepare(d.srs.read_size_),
                     std::move(*this));
             return;
 
@@ -136,6 +129,7 @@ read_some_op<MutableBufferSequence, Handler>::operator()(
         case 3:
             d.state = 4;
             d.srs.sb_.commit(bytes_transferred);
+            d.srs.adapt(bytes_transferred);
             break;
 
         // copy
@@ -149,7 +143,122 @@ read_some_op<MutableBufferSequence, Handler>::operator()(
             break;
         }
     }
-    d.h(ec, bytes_transferred);
+    d_.invoke(ec, bytes_transferred);
+}
+
+//------------------------------------------------------------------------------
+
+template<class Stream, class DynamicBuffer>
+template<class Handler>
+class dynabuf_readstream<
+    Stream, DynamicBuffer>::fill_op
+{
+    struct data
+    {
+        dynabuf_readstream& srs;
+        std::size_t n;
+        int state = 0;
+
+        data(Handler& h, dynabuf_readstream& srs_,
+                std::size_t n_)
+            : srs(srs_)
+            , n(n_)
+        {
+        }
+    };
+
+    handler_ptr<data, Handler> d_;
+
+public:
+    fill_op(fill_op&&) = default;
+    fill_op(fill_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    fill_op(DeducedHandler&& h,
+            dynabuf_readstream& srs, Args&&... args)
+        : d_(std::forward<DeducedHandler>(h),
+            srs, std::forward<Args>(args)...)
+    {
+        (*this)(error_code{}, 0);
+    }
+
+    void
+    operator()(error_code const& ec,
+        std::size_t bytes_transferred);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, fill_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_.handler());
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, fill_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_.handler());
+    }
+
+    friend
+    bool asio_handler_is_continuation(fill_op* op)
+    {
+        return boost_asio_handler_cont_helpers::
+            is_continuation(op->d_.handler());
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, fill_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_.handler());
+    }
+};
+
+template<class Stream, class DynamicBuffer>
+template<class Handler>
+void
+dynabuf_readstream<Stream, DynamicBuffer>::
+fill_op<Handler>::operator()(error_code const& ec,
+    std::size_t bytes_transferred)
+{
+    auto& d = *d_;
+    while(! ec && d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            if(d.srs.sb_.size() >= d.n)
+            {
+                // already buffered
+                d.state = 99;
+                d.srs.get_io_service().post(
+                    bind_handler(std::move(*this), ec, 0));
+                return;
+            }
+            d.state = 1;
+            break;
+
+        case 1:
+            // read
+            d.state = 2;
+            d.srs.next_layer_.async_read_some(
+                d.srs.sb_.prepare(std::max(d.n -
+                    d.srs.sb_.size(), d.srs.read_size_)),
+                        std::move(*this));
+            return;
+
+        // got data
+        case 2:
+            d.srs.sb_.commit(bytes_transferred);
+            d.state = d.srs.sb_.size() < d.n ? 1 : 99;
+            break;
+        }
+    }
+    d_.invoke(ec);
 }
 
 //------------------------------------------------------------------------------
@@ -162,6 +271,76 @@ dynabuf_readstream(Args&&... args)
 {
 }
 
+template<class Stream, class DynamicBuffer>
+void
+dynabuf_readstream<Stream, DynamicBuffer>::
+capacity(std::size_t size)
+{
+    // Start small, reads grow the read-ahead as needed
+    capacity_ = size;
+    read_size_ = std::min<std::size_t>(size, 512);
+}
+
+template<class Stream, class DynamicBuffer>
+void
+dynabuf_readstream<Stream, DynamicBuffer>::
+adapt(std::size_t bytes_transferred)
+{
+    // A read which fills the read-ahead means more data was
+    // probably waiting, while a read returning much less means
+    // the peer is mostly idle and the larger buffer is wasted.
+    if(bytes_transferred >= read_size_)
+        read_size_ = std::min(capacity_, 2 * read_size_);
+    else if(bytes_transferred < read_size_ / 4)
+        read_size_ = std::max(std::min<std::size_t>(
+            capacity_, 512), read_size_ / 2);
+}
+
+template<class Stream, class DynamicBuffer>
+void
+dynabuf_readstream<Stream, DynamicBuffer>::
+fill(std::size_t n)
+{
+    error_code ec;
+    fill(n, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class Stream, class DynamicBuffer>
+void
+dynabuf_readstream<Stream, DynamicBuffer>::
+fill(std::size_t n, error_code& ec)
+{
+    static_assert(is_SyncReadStream<next_layer_type>::value,
+        "SyncReadStream requirements not met");
+    ec = {};
+    while(sb_.size() < n)
+    {
+        sb_.commit(next_layer_.read_some(sb_.prepare(
+            std::max(n - sb_.size(), read_size_)), ec));
+        if(ec)
+            return;
+    }
+}
+
+template<class Stream, class DynamicBuffer>
+template<class ReadHandler>
+auto
+dynabuf_readstream<Stream, DynamicBuffer>::
+async_fill(std::size_t n, ReadHandler&& handler) ->
+    typename async_completion<
+        ReadHandler, void(error_code)>::result_type
+{
+    static_assert(is_AsyncReadStream<next_layer_type>::value,
+        "Stream requirements not met");
+    beast::async_completion<
+        ReadHandler, void(error_code)> completion(handler);
+    fill_op<decltype(completion.handler)>{
+        completion.handler, *this, n};
+    return completion.result.get();
+}
+
 template<class Stream, class DynamicBuffer>
 template<class ConstBufferSequence, class WriteHandler>
 auto
@@ -218,12 +397,15 @@ read_some(MutableBufferSequence const& buffers,
     using boost::asio::buffer_copy;
     if(sb_.size() == 0)
     {
-        if(capacity_ == 0)
+        // Large reads bypass the buffer
+        if(buffer_size(buffers) >= read_size_)
             return next_layer_.read_some(buffers, ec);
-        sb_.commit(next_layer_.read_some(
-            sb_.prepare(capacity_), ec));
+        auto const n = next_layer_.read_some(
+            sb_.prepare(read_size_), ec);
+        sb_.commit(n);
         if(ec)
             return 0;
+        adapt(n);
     }
     auto bytes_transferred =
         buffer_copy(buffers, sb_.data());
@@ -0,0 +1,295 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_FLAT_STREAMBUF_IPP
+#define BEAST_IMPL_FLAT_STREAMBUF_IPP
+
+#include <beast/core/detail/type_traits.hpp>
+#include <beast/core/detail/write_dynabuf.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace beast {
+
+/*  Layout of the buffer:
+
+    p_       in_         out_        last_          end_
+    |<------>|<---------->|<---------->|<------------>|
+      spent      input        output       unused
+
+    The input sequence is moved back to p_ only when the output
+    sequence would not otherwise fit, so the cost of compaction is
+    proportional to the amount of data read, not to the calls.
+*/
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+~basic_flat_streambuf()
+{
+    deallocate();
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf&& other)
+    : detail::empty_base_optimization<allocator_type>(
+        std::move(other.member()))
+    , max_(other.max_)
+{
+    move_from(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf&& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    deallocate();
+    max_ = other.max_;
+    move_assign(other, std::integral_constant<bool,
+        alloc_traits::propagate_on_container_move_assignment::value>{});
+    return *this;
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf const& other)
+    : detail::empty_base_optimization<allocator_type>(
+        alloc_traits::select_on_container_copy_construction(
+            other.member()))
+    , max_(other.max_)
+{
+    commit(boost::asio::buffer_copy(
+        prepare(other.size()), other.data()));
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf const& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    deallocate();
+    max_ = other.max_;
+    copy_assign(other, std::integral_constant<bool,
+        alloc_traits::propagate_on_container_copy_assignment::value>{});
+    commit(boost::asio::buffer_copy(
+        prepare(other.size()), other.data()));
+    return *this;
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(std::size_t limit, Allocator const& alloc)
+    : detail::empty_base_optimization<allocator_type>(alloc)
+    , max_(limit)
+{
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n <= static_cast<std::size_t>(end_ - out_))
+    {
+        last_ = out_ + n;
+        return mutable_buffers_type(out_, n);
+    }
+    auto const len = size();
+    if(n > max_ - len)
+        throw std::length_error{
+            "flat_streambuf overflow"};
+    if(n <= capacity() - len)
+    {
+        // Make room by moving the input to the front
+        if(len > 0)
+            std::memmove(p_, in_, len);
+        in_ = p_;
+        out_ = p_ + len;
+    }
+    else
+    {
+        // Grow geometrically, up to the limit
+        auto const cap = capacity() > max_ / 2 ?
+            max_ : 2 * capacity();
+        reallocate((std::max)(cap, len + n));
+    }
+    last_ = out_ + n;
+    return mutable_buffers_type(out_, n);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+consume(std::size_t n)
+{
+    if(n < size())
+    {
+        in_ += n;
+        return;
+    }
+    in_ = out_;
+    // Start over at the front when there is no output
+    if(out_ == last_)
+    {
+        in_ = p_;
+        out_ = p_;
+        last_ = p_;
+    }
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+reserve(std::size_t n)
+{
+    if(n > max_)
+        throw std::length_error{
+            "flat_streambuf overflow"};
+    if(n > capacity())
+        reallocate(n);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+shrink_to_fit()
+{
+    auto const len = size();
+    if(len == capacity())
+        return;
+    if(len == 0)
+    {
+        deallocate();
+        return;
+    }
+    reallocate(len);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_from(basic_flat_streambuf& other)
+{
+    p_ = other.p_;
+    in_ = other.in_;
+    out_ = other.out_;
+    last_ = other.out_;
+    end_ = other.end_;
+    other.p_ = nullptr;
+    other.in_ = nullptr;
+    other.out_ = nullptr;
+    other.last_ = nullptr;
+    other.end_ = nullptr;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_assign(basic_flat_streambuf& other, std::false_type)
+{
+    if(this->member() != other.member())
+    {
+        commit(boost::asio::buffer_copy(
+            prepare(other.size()), other.data()));
+        other.deallocate();
+    }
+    else
+        move_assign(other, std::true_type{});
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_assign(basic_flat_streambuf& other, std::true_type)
+{
+    this->member() = std::move(other.member());
+    move_from(other);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_assign(basic_flat_streambuf const& other, std::false_type)
+{
+    beast::detail::ignore_unused(other);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_assign(basic_flat_streambuf const& other, std::true_type)
+{
+    this->member() = other.member();
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+reallocate(std::size_t capacity)
+{
+    auto const len = size();
+    auto const p = alloc_traits::allocate(
+        this->member(), capacity);
+    if(len > 0)
+        std::memcpy(p, in_, len);
+    deallocate();
+    p_ = p;
+    in_ = p;
+    out_ = p + len;
+    last_ = out_;
+    end_ = p + capacity;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+deallocate()
+{
+    if(p_)
+        alloc_traits::deallocate(
+            this->member(), p_, capacity());
+    p_ = nullptr;
+    in_ = nullptr;
+    out_ = nullptr;
+    last_ = nullptr;
+    end_ = nullptr;
+}
+
+template<class Allocator>
+std::size_t
+read_size_helper(basic_flat_streambuf<
+    Allocator> const& streambuf, std::size_t max_size)
+{
+    // Avoid small reads when the buffer is nearly full,
+    // prepare makes room by compacting or growing.
+    std::size_t constexpr low = 512;
+    auto const avail = streambuf.capacity() - streambuf.size();
+    return (std::min)((std::min)(max_size,
+        streambuf.max_size() - streambuf.size()),
+            (std::max)(low, avail));
+}
+
+template<class Allocator, class T>
+basic_flat_streambuf<Allocator>&
+operator<<(basic_flat_streambuf<Allocator>& streambuf, T const& t)
+{
+    detail::write_dynabuf(streambuf, t);
+    return streambuf;
+}
+
+} // beast
+
+#endif
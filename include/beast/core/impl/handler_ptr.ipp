@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_HANDLER_PTR_IPP
+#define BEAST_IMPL_HANDLER_PTR_IPP
+
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/assert.hpp>
+#include <new>
+
+namespace beast {
+
+template<class T, class Handler>
+handler_ptr<T, Handler>::
+~handler_ptr()
+{
+    if(! p_ || --p_->n > 0)
+        return;
+    if(p_->live)
+        p_->get().~T();
+    Handler h(std::move(p_->handler));
+    p_->~P();
+    boost_asio_handler_alloc_helpers::
+        deallocate(p_, sizeof(P), h);
+}
+
+template<class T, class Handler>
+template<class DeducedHandler, class... Args>
+handler_ptr<T, Handler>::
+handler_ptr(DeducedHandler&& handler, Args&&... args)
+{
+    // Allocate using a handler of the final type, so
+    // that the same customization releases the memory.
+    Handler h(std::forward<DeducedHandler>(handler));
+    p_ = static_cast<P*>(boost_asio_handler_alloc_helpers::
+        allocate(sizeof(P), h));
+    try
+    {
+        ::new(p_) P(std::move(h));
+    }
+    catch(...)
+    {
+        boost_asio_handler_alloc_helpers::
+            deallocate(p_, sizeof(P), h);
+        throw;
+    }
+    try
+    {
+        ::new(&p_->t) T(p_->handler,
+            std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+        Handler h2(std::move(p_->handler));
+        p_->~P();
+        boost_asio_handler_alloc_helpers::
+            deallocate(p_, sizeof(P), h2);
+        throw;
+    }
+}
+
+template<class T, class Handler>
+auto
+handler_ptr<T, Handler>::
+release_handler() ->
+    Handler
+{
+    BOOST_ASSERT(p_ && p_->live);
+    auto const p = p_;
+    p_ = nullptr;
+    p->get().~T();
+    p->live = false;
+    if(--p->n > 0)
+        return p->handler;
+    Handler h(std::move(p->handler));
+    p->~P();
+    boost_asio_handler_alloc_helpers::
+        deallocate(p, sizeof(P), h);
+    return h;
+}
+
+template<class T, class Handler>
+template<class... Args>
+void
+handler_ptr<T, Handler>::
+invoke(Args&&... args)
+{
+    auto h = release_handler();
+    h(std::forward<Args>(args)...);
+}
+
+} // beast
+
+#endif
@@ -22,22 +22,34 @@ void
 prepared_buffers<BufferSequence>::
 setup(std::size_t n)
 {
-    for(end_ = bs_.begin(); end_ != bs_.end(); ++end_)
+    nend_ = 0;
+    for(end_ = bs_.begin(); end_ != bs_.end(); ++end_, ++nend_)
     {
         auto const len =
             boost::asio::buffer_size(*end_);
         if(n <= len)
         {
             size_ = n;
+            nback_ = nend_++;
             back_ = end_++;
             return;
         }
         n -= len;
     }
     size_ = 0;
+    nback_ = nend_;
     back_ = end_;
 }
 
+template<class BufferSequence>
+void
+prepared_buffers<BufferSequence>::
+reseat()
+{
+    back_ = std::next(bs_.begin(), nback_);
+    end_ = nend_ == nback_ ? back_ : std::next(back_);
+}
+
 template<class BufferSequence>
 class prepared_buffers<BufferSequence>::const_iterator
 {
@@ -130,8 +142,7 @@ template<class BufferSequence>
 prepared_buffers<BufferSequence>::
 prepared_buffers(prepared_buffers&& other)
     : prepared_buffers(std::move(other),
-        std::distance<iter_type>(other.bs_.begin(), other.back_),
-        std::distance<iter_type>(other.bs_.begin(), other.end_))
+        other.nback_, other.nend_)
 {
 }
 
@@ -139,8 +150,7 @@ template<class BufferSequence>
 prepared_buffers<BufferSequence>::
 prepared_buffers(prepared_buffers const& other)
     : prepared_buffers(other,
-        std::distance<iter_type>(other.bs_.begin(), other.back_),
-        std::distance<iter_type>(other.bs_.begin(), other.end_))
+        other.nback_, other.nend_)
 {
 }
 
@@ -150,14 +160,11 @@ prepared_buffers<BufferSequence>::
 operator=(prepared_buffers&& other) ->
     prepared_buffers&
 {
-    auto const nback = std::distance<iter_type>(
-        other.bs_.begin(), other.back_);
-    auto const nend = std::distance<iter_type>(
-        other.bs_.begin(), other.end_);
-    bs_ = std::move(other.bs_);
-    back_ = std::next(bs_.begin(), nback);
-    end_ = std::next(bs_.begin(), nend);
+    nback_ = other.nback_;
+    nend_ = other.nend_;
     size_ = other.size_;
+    bs_ = std::move(other.bs_);
+    reseat();
     return *this;
 }
 
@@ -167,14 +174,11 @@ prepared_buffers<BufferSequence>::
 operator=(prepared_buffers const& other) ->
     prepared_buffers&
 {
-    auto const nback = std::distance<iter_type>(
-        other.bs_.begin(), other.back_);
-    auto const nend = std::distance<iter_type>(
-        other.bs_.begin(), other.end_);
-    bs_ = other.bs_;
-    back_ = std::next(bs_.begin(), nback);
-    end_ = std::next(bs_.begin(), nend);
+    nback_ = other.nback_;
+    nend_ = other.nend_;
     size_ = other.size_;
+    bs_ = other.bs_;
+    reseat();
     return *this;
 }
 
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_STATIC_BUFFER_SEQUENCE_IPP
+#define BEAST_IMPL_STATIC_BUFFER_SEQUENCE_IPP
+
+#include <beast/core/buffer_concepts.hpp>
+#include <stdexcept>
+
+namespace beast {
+
+template<std::size_t N>
+template<class... ConstBufferSequence>
+static_buffer_sequence<N>::
+static_buffer_sequence(ConstBufferSequence const&... buffers)
+{
+    append_all(buffers...);
+}
+
+template<std::size_t N>
+template<class U0, class... Us>
+void
+static_buffer_sequence<N>::
+append_all(U0 const& u0, Us const&... us)
+{
+    append(u0);
+    append_all(us...);
+}
+
+template<std::size_t N>
+void
+static_buffer_sequence<N>::
+push_back(boost::asio::const_buffer const& buffer)
+{
+    if(boost::asio::buffer_size(buffer) == 0)
+        return;
+    if(n_ >= N)
+        throw std::length_error{
+            "static_buffer_sequence overflow"};
+    a_[n_++] = buffer;
+}
+
+template<std::size_t N>
+template<class ConstBufferSequence>
+void
+static_buffer_sequence<N>::
+append(ConstBufferSequence const& buffers)
+{
+    static_assert(is_ConstBufferSequence<ConstBufferSequence>::value,
+        "ConstBufferSequence requirements not met");
+    auto const n = n_;
+    for(boost::asio::const_buffer const b : buffers)
+    {
+        if(boost::asio::buffer_size(b) == 0)
+            continue;
+        if(n_ >= N)
+        {
+            n_ = n;
+            throw std::length_error{
+                "static_buffer_sequence overflow"};
+        }
+        a_[n_++] = b;
+    }
+}
+
+} // beast
+
+#endif
@@ -57,6 +57,11 @@ prepare_buffer(std::size_t n,
     subset of the original list of buffers starting with the first
     byte of the original sequence.
 
+    Copies and moves remember the position of the last buffer instead
+    of measuring it, so they are constant time when the wrapped
+    sequence has random access iterators, and linear in the number
+    of buffers presented otherwise.
+
     @tparam BufferSequence The buffer sequence to wrap.
 */
 template<class BufferSequence>
@@ -68,16 +73,19 @@ class prepared_buffers
     BufferSequence bs_;
     iter_type back_;
     iter_type end_;
+    std::size_t nback_;
+    std::size_t nend_;
     std::size_t size_;
 
     template<class Deduced>
     prepared_buffers(Deduced&& other,
             std::size_t nback, std::size_t nend)
         : bs_(std::forward<Deduced>(other).bs_)
-        , back_(std::next(bs_.begin(), nback))
-        , end_(std::next(bs_.begin(), nend))
+        , nback_(nback)
+        , nend_(nend)
         , size_(other.size_)
     {
+        reseat();
     }
 
 public:
@@ -128,6 +136,9 @@ public:
 private:
     void
     setup(std::size_t n);
+
+    void
+    reseat();
 };
 
 //------------------------------------------------------------------------------
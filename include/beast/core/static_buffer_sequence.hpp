@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_STATIC_BUFFER_SEQUENCE_HPP
+#define BEAST_STATIC_BUFFER_SEQUENCE_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <cstddef>
+
+namespace beast {
+
+/** A @b `ConstBufferSequence` with a fixed capacity.
+
+    This holds up to `N` buffers in an array, along with a count.
+    Iterators are plain pointers, so the sequence is cheap to copy
+    and to walk, and maps directly onto the scatter/gather array
+    of a system call. It is intended for gather writes made of a
+    small, bounded number of pieces, such as headers, chunk framing
+    and body, where @ref buffer_cat would otherwise produce a deeply
+    nested iterator type.
+
+    Empty buffers are not stored. Ownership of the underlying memory
+    is not transferred, the caller is responsible for keeping it
+    valid while the sequence is in use.
+
+    @tparam N The maximum number of buffers in the sequence.
+*/
+template<std::size_t N>
+class static_buffer_sequence
+{
+    std::array<boost::asio::const_buffer, N> a_;
+    std::size_t n_ = 0;
+
+    void
+    append_all()
+    {
+    }
+
+    template<class U0, class... Us>
+    void
+    append_all(U0 const& u0, Us const&... us);
+
+public:
+    /// The type for each element in the list of buffers.
+    using value_type = boost::asio::const_buffer;
+
+#if GENERATING_DOCS
+    /// A random access iterator type that may be used to read elements.
+    using const_iterator = implementation_defined;
+
+#else
+    using const_iterator = value_type const*;
+
+#endif
+
+    /// Default constructor. The sequence is empty.
+    static_buffer_sequence() = default;
+
+    /// Copy constructor.
+    static_buffer_sequence(static_buffer_sequence const&) = default;
+
+    /// Copy assignment.
+    static_buffer_sequence& operator=(
+        static_buffer_sequence const&) = default;
+
+    /** Construct from a list of buffer sequences.
+
+        Each sequence is appended in order.
+
+        @throws std::length_error if the buffers do not fit.
+    */
+    template<class... ConstBufferSequence>
+    explicit
+    static_buffer_sequence(ConstBufferSequence const&... buffers);
+
+    /// Returns the maximum number of buffers in the sequence.
+    static
+    constexpr
+    std::size_t
+    capacity()
+    {
+        return N;
+    }
+
+    /// Returns the number of buffers in the sequence.
+    std::size_t
+    size() const
+    {
+        return n_;
+    }
+
+    /// Get a random access iterator to the first element.
+    const_iterator
+    begin() const
+    {
+        return a_.data();
+    }
+
+    /// Get a random access iterator for one past the last element.
+    const_iterator
+    end() const
+    {
+        return a_.data() + n_;
+    }
+
+    /// Remove all buffers from the sequence.
+    void
+    clear()
+    {
+        n_ = 0;
+    }
+
+    /** Append a buffer to the sequence.
+
+        @throws std::length_error if the sequence is full.
+    */
+    void
+    push_back(boost::asio::const_buffer const& buffer);
+
+    /** Append the buffers in a sequence.
+
+        @throws std::length_error if the buffers do not fit. The
+        sequence is left unchanged in that case.
+    */
+    template<class ConstBufferSequence>
+    void
+    append(ConstBufferSequence const& buffers);
+};
+
+} // beast
+
+#include <beast/core/impl/static_buffer_sequence.ipp>
+
+#endif
@@ -31,12 +31,18 @@ namespace beast {
 
     @li A type meeting the requirements of @b `MutableBufferSequence`
 
+    @li `boost::string_ref` and @ref static_string
+
+    @li Integers other than `bool` and the character types
+
     For all types not listed above, the function will invoke
     `boost::lexical_cast` on the argument in an attempt to convert to
     a string, which is then appended to the dynamic buffer.
 
     When this function serializes numbers, it converts them to
     their text representation as if by a call to `std::to_string`.
+    Integers are formatted on the stack and copied into the memory
+    returned by `prepare`, without constructing a temporary string.
 
     @param dynabuf The dynamic buffer to write to.
 
@@ -11,18 +11,22 @@
 #include <beast/http/basic_headers.hpp>
 #include <beast/http/basic_parser_v1.hpp>
 #include <beast/http/body_type.hpp>
+#include <beast/http/date.hpp>
 #include <beast/http/empty_body.hpp>
+#include <beast/http/header_serializer.hpp>
 #include <beast/http/headers.hpp>
 #include <beast/http/message.hpp>
 #include <beast/http/parse.hpp>
 #include <beast/http/parse_error.hpp>
 #include <beast/http/parser_v1.hpp>
+#include <beast/http/pipeline.hpp>
 #include <beast/http/read.hpp>
 #include <beast/http/reason.hpp>
 #include <beast/http/resume_context.hpp>
 #include <beast/http/rfc7230.hpp>
 #include <beast/http/streambuf_body.hpp>
 #include <beast/http/string_body.hpp>
+#include <beast/http/verb.hpp>
 #include <beast/http/write.hpp>
 
 #endif
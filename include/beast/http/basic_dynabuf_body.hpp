@@ -56,6 +56,24 @@ private:
             sb_.commit(buffer_copy(
                 sb_.prepare(size), buffer(data, size)));
         }
+
+        void
+        reserve(std::uint64_t)
+        {
+            // The dynamic buffer allocates in prepare
+        }
+
+        typename DynamicBuffer::mutable_buffers_type
+        prepare(std::size_t n)
+        {
+            return sb_.prepare(n);
+        }
+
+        void
+        commit(std::size_t n) noexcept
+        {
+            sb_.commit(n);
+        }
     };
 
     class writer
@@ -84,9 +102,8 @@ private:
         }
 
         template<class WriteFunction>
-        boost::tribool
-        write(resume_context&&, error_code&,
-            WriteFunction&& wf) noexcept
+        bool
+        write(error_code&, WriteFunction&& wf) noexcept
         {
             wf(body_.data());
             return true;
@@ -9,6 +9,7 @@
 #define BEAST_HTTP_BASIC_HEADERS_HPP
 
 #include <beast/core/detail/empty_base_optimization.hpp>
+#include <beast/core/detail/format_uint.hpp>
 #include <beast/http/detail/basic_headers.hpp>
 #include <boost/lexical_cast.hpp>
 #include <algorithm>
@@ -260,12 +261,35 @@ public:
     */
     template<class T>
     typename std::enable_if<
-        ! std::is_constructible<boost::string_ref, T>::value>::type
+        ! std::is_constructible<boost::string_ref, T>::value &&
+        ! beast::detail::is_formattable_integer<T>::value>::type
     insert(boost::string_ref name, T const& value)
     {
         insert(name, boost::lexical_cast<std::string>(value));
     }
 
+    /** Insert a field value.
+
+        If a field with the same name already exists, the
+        existing field is untouched and a new field value pair
+        is inserted into the container.
+
+        @param name The name of the field
+
+        @param value The value of the field. The integer is
+        formatted in decimal without a temporary string.
+    */
+    template<class T>
+    typename std::enable_if<
+        beast::detail::is_formattable_integer<T>::value>::type
+    insert(boost::string_ref name, T value)
+    {
+        char buf[beast::detail::max_uint_digits + 1];
+        auto const end = beast::detail::format_int(buf, value);
+        insert(name, boost::string_ref{buf,
+            static_cast<std::size_t>(end - buf)});
+    }
+
     /** Replace a field value.
 
         First removes any values with matching field names, then
@@ -290,12 +314,34 @@ public:
     */
     template<class T>
     typename std::enable_if<
-        ! std::is_constructible<boost::string_ref, T>::value>::type
+        ! std::is_constructible<boost::string_ref, T>::value &&
+        ! beast::detail::is_formattable_integer<T>::value>::type
     replace(boost::string_ref const& name, T const& value)
     {
         replace(name,
             boost::lexical_cast<std::string>(value));
     }
+
+    /** Replace a field value.
+
+        First removes any values with matching field names, then
+        inserts the new field value.
+
+        @param name The name of the field
+
+        @param value The value of the field. The integer is
+        formatted in decimal without a temporary string.
+    */
+    template<class T>
+    typename std::enable_if<
+        beast::detail::is_formattable_integer<T>::value>::type
+    replace(boost::string_ref const& name, T value)
+    {
+        char buf[beast::detail::max_uint_digits + 1];
+        auto const end = beast::detail::format_int(buf, value);
+        replace(name, boost::string_ref{buf,
+            static_cast<std::size_t>(end - buf)});
+    }
 };
 
 } // http
@@ -123,6 +123,53 @@ enum class body_what
     pause
 };
 
+/** The default feature policy of @ref basic_parser_v1.
+
+    A policy is a class with the static `bool` constants shown
+    below. Each one turns on one feature of the parser. When a
+    feature is off, the code for it is removed from the parser at
+    compile time, and a message that needs the feature fails with
+    an error. To make a specialized parser, derive from this class
+    and hide the members to change. For example, a strict parser
+    for requests without chunked uploads:
+
+    @code
+    struct strict_policy : parser_policy
+    {
+        static bool constexpr obs_fold = false;
+        static bool constexpr chunked = false;
+    };
+
+    template<class Derived>
+    using strict_parser = basic_parser_v1<true, Derived, strict_policy>;
+    @endcode
+*/
+struct parser_policy
+{
+    /** Accept obsolete line folding in field values.
+
+        When `false`, a field value continued on the next line
+        fails with @ref parse_error::illegal_obs_fold.
+    */
+    static bool constexpr obs_fold = true;
+
+    /** Accept the Transfer-Encoding field and chunked bodies.
+
+        When `false`, the chunk decoding states are never entered,
+        and a message with a Transfer-Encoding field fails with
+        @ref parse_error::illegal_transfer_encoding.
+    */
+    static bool constexpr chunked = true;
+
+    /** Recognize upgrade messages.
+
+        When `false`, the Upgrade field and the "upgrade" token
+        in the Connection field are not matched, and
+        @ref basic_parser_v1::upgrade always returns `false`.
+    */
+    static bool constexpr upgrade = true;
+};
+
 /// The value returned when no content length is known or applicable.
 static std::uint64_t constexpr no_content_length =
     std::numeric_limits<std::uint64_t>::max();
@@ -221,12 +268,16 @@ static std::uint64_t constexpr no_content_length =
 
     @tparam Derived The derived class type. This is part of the
     Curiously Recurring Template Pattern interface.
+
+    @tparam Policy A class which turns parser features on or off
+    at compile time. See @ref parser_policy for the requirements.
 */
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived,
+    class Policy = parser_policy>
 class basic_parser_v1 : public detail::parser_base
 {
 private:
-    template<bool, class>
+    template<bool, class, class>
     friend class basic_parser_v1;
 
     using self = basic_parser_v1;
@@ -293,12 +344,12 @@ public:
     /// Copy constructor.
     template<class OtherDerived>
     basic_parser_v1(basic_parser_v1<
-        isRequest, OtherDerived> const& other);
+        isRequest, OtherDerived, Policy> const& other);
 
     /// Copy assignment.
     template<class OtherDerived>
     basic_parser_v1& operator=(basic_parser_v1<
-        isRequest, OtherDerived> const& other);
+        isRequest, OtherDerived, Policy> const& other);
 
     /** Set options on the parser.
 
@@ -417,6 +468,22 @@ public:
     bool
     keep_alive() const;
 
+    /** Returns the number of body octets not yet received.
+
+        When the parser is positioned in the body of a message whose
+        length is given by the Content-Length field, this returns the
+        number of body octets which have not yet been parsed. In all
+        other cases, including chunked bodies and bodies terminated
+        by end of file, zero is returned.
+    */
+    std::uint64_t
+    body_remaining() const
+    {
+        if(s_ != s_body_identity0 && s_ != s_body_identity)
+            return 0;
+        return content_length_;
+    }
+
     /** Returns `true` if the parse has completed succesfully.
 
         When the parse has completed successfully, and the semantics
@@ -486,6 +553,35 @@ protected:
     void
     reset();
 
+    /** Returns the body maximum size, or zero if there is no limit.
+
+        When a limit is set, the parser rejects a message whose
+        Content-Length exceeds it after `on_body_what` returns,
+        unless the body is skipped.
+    */
+    std::size_t
+    body_limit() const
+    {
+        return b_max_;
+    }
+
+    /** Consume body octets which were stored without parsing.
+
+        Derived classes which receive body octets directly into
+        the body storage, instead of through `write`, call this
+        function to advance the parser past those octets. The
+        `on_body` callback is not invoked for them. When the last
+        octet of the body is consumed, `on_complete` is called.
+
+        @param n The number of octets consumed. This must be greater
+        than zero, and not more than the value returned by
+        @ref body_remaining.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    consume_body(std::size_t n, error_code& ec);
+
 private:
     Derived&
     impl()
@@ -8,6 +8,7 @@
 #ifndef BEAST_HTTP_TYPE_CHECK_HPP
 #define BEAST_HTTP_TYPE_CHECK_HPP
 
+#include <beast/core/buffer_concepts.hpp>
 #include <beast/core/error.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <beast/http/resume_context.hpp>
@@ -82,6 +83,25 @@ struct is_Writer<T, M, beast::detail::void_t<decltype(
 
 #else
 
+// Detects a writer whose write function takes no resume
+// context. Such writers never suspend the operation.
+template<class T, class = beast::detail::void_t<>>
+struct has_sync_write : std::false_type {};
+
+template<class T>
+struct has_sync_write<T, beast::detail::void_t<decltype(
+    std::declval<T>().template write<detail::write_function>(
+        std::declval<error_code&>(),
+        std::declval<detail::write_function>())
+            )> > : std::integral_constant<bool,
+    std::is_convertible<decltype(
+        std::declval<T>().template write<detail::write_function>(
+            std::declval<error_code&>(),
+            std::declval<detail::write_function>())),
+                bool>::value>
+{
+};
+
 template<class T, class M>
 class is_Writer
 {
@@ -116,12 +136,35 @@ public:
     using type = std::integral_constant<bool,
         std::is_nothrow_constructible<T, M const&>::value
         && type1::value
-        && type2::value
+        && (type2::value || has_sync_write<T>::value)
     >;
 };
 
 #endif
 
+template<class T, class = beast::detail::void_t<>>
+struct is_DirectReader : std::false_type {};
+
+template<class T>
+struct is_DirectReader<T, beast::detail::void_t<decltype(
+    std::declval<T>().reserve(std::declval<std::uint64_t>()),
+    std::declval<T>().prepare(std::declval<std::size_t>()),
+    std::declval<T>().commit(std::declval<std::size_t>())
+        )> > : std::integral_constant<bool,
+    is_MutableBufferSequence<decltype(
+        std::declval<T>().prepare(std::declval<std::size_t>()))>::value
+        >
+{
+};
+
+template<class T, class = beast::detail::void_t<>>
+struct has_finish : std::false_type {};
+
+template<class T>
+struct has_finish<T, beast::detail::void_t<decltype(
+    std::declval<T&>().finish(std::declval<error_code&>())
+        )> > : std::true_type {};
+
 template<class T>
 class is_Parser
 {
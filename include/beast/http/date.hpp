@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DATE_HPP
+#define BEAST_HTTP_DATE_HPP
+
+#include <beast/http/detail/date.hpp>
+#include <ctime>
+
+namespace beast {
+namespace http {
+
+/// The number of characters in a formatted HTTP-date.
+static std::size_t constexpr date_size = detail::date_size;
+
+/** Format a time as an HTTP-date.
+
+    The preferred IMF-fixdate format is used (rfc7231 7.1.1.1),
+    for example "Sun, 06 Nov 1994 08:49:37 GMT". The result does
+    not depend on the locale.
+
+    @param dest A pointer to storage for at least @ref date_size
+    characters. No null terminator is written.
+
+    @param t The time to format.
+
+    @return A pointer to one past the last character written.
+*/
+inline
+char*
+format_date(char* dest, std::time_t t)
+{
+    return detail::format_date(dest, t);
+}
+
+/** Copy the current time as an HTTP-date.
+
+    The date string is shared by all threads in the process and
+    formatted at most once per second, so calling this function
+    is about as cheap as copying @ref date_size characters. Readers
+    never block each other, nor wait on a lock.
+
+    @param dest A pointer to storage for at least @ref date_size
+    characters. No null terminator is written.
+
+    @return A pointer to one past the last character written.
+*/
+inline
+char*
+current_date(char* dest)
+{
+    return detail::date_cache<>::instance().copy(dest);
+}
+
+} // http
+} // beast
+
+#endif
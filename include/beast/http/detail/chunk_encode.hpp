@@ -53,12 +53,25 @@ public:
     using const_iterator = value_type const*;
 
     chunk_encode_text(chunk_encode_text const& other)
+    {
+        *this = other;
+    }
+
+    chunk_encode_text&
+    operator=(chunk_encode_text const& other)
     {
         auto const n =
             boost::asio::buffer_size(other.cb_);
         buf_ = other.buf_;
         cb_ = boost::asio::const_buffer(
-            &buf_[buf_.size() - n], n);
+            buf_.data() + buf_.size() - n, n);
+        return *this;
+    }
+
+    // Construct an empty chunk header
+    chunk_encode_text()
+        : cb_(buf_.data() + buf_.size(), 0)
+    {
     }
 
     explicit
@@ -85,6 +98,26 @@ public:
     }
 };
 
+/** Returns the buffer which follows the body of a chunk.
+
+    @param chunk `true` if a chunk was started, so that
+    it needs a delimiter.
+
+    @param last `true` if the final chunk should be appended.
+*/
+inline
+boost::asio::const_buffers_1
+chunk_encode_delim(bool chunk, bool last)
+{
+    // The chunk delimiter followed by the final chunk
+    static char const trailer[] = "\r\n0\r\n\r\n";
+    if(! chunk)
+        return boost::asio::const_buffers_1{
+            trailer + 2, last ? 5u : 0u};
+    return boost::asio::const_buffers_1{
+        trailer, last ? 7u : 2u};
+}
+
 /** Returns a chunk-encoded ConstBufferSequence.
 
     This returns a buffer sequence representing the
@@ -112,6 +145,40 @@ chunk_encode(ConstBufferSequence const& buffers)
         boost::asio::const_buffers_1{"\r\n", 2});
 }
 
+/** Returns a chunk-encoded ConstBufferSequence.
+
+    This returns a buffer sequence representing one chunk of a
+    chunked transfer coded body, optionally followed by the final
+    chunk, so that both may be sent in a single write. When the
+    input is empty no chunk is produced, since an empty chunk
+    would end the body.
+
+    @param last `true` if the final chunk should be appended.
+
+    @param buffers The input buffer sequence.
+
+    @return A chunk-encoded ConstBufferSequence representing the input.
+
+    @see <a href=https://tools.ietf.org/html/rfc7230#section-4.1.3>rfc7230 section 4.1.3</a>
+*/
+template<class ConstBufferSequence>
+#if GENERATING_DOCS
+implementation_defined
+#else
+beast::detail::buffer_cat_helper<boost::asio::const_buffer,
+    chunk_encode_text, ConstBufferSequence, boost::asio::const_buffers_1>
+#endif
+chunk_encode(bool last, ConstBufferSequence const& buffers)
+{
+    using boost::asio::buffer_size;
+    auto const n = buffer_size(buffers);
+    if(n == 0)
+        return buffer_cat(chunk_encode_text{}, buffers,
+            chunk_encode_delim(false, last));
+    return buffer_cat(chunk_encode_text{n}, buffers,
+        chunk_encode_delim(true, last));
+}
+
 /// Returns a chunked encoding final chunk.
 inline
 #if GENERATING_DOCS
@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_DATE_HPP
+#define BEAST_HTTP_DETAIL_DATE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+// The size of an IMF-fixdate, "Sun, 06 Nov 1994 08:49:37 GMT"
+static std::size_t constexpr date_size = 29;
+
+inline
+char*
+format_2digits(char* p, int v)
+{
+    *p++ = static_cast<char>('0' + v / 10);
+    *p++ = static_cast<char>('0' + v % 10);
+    return p;
+}
+
+template<class = void>
+char*
+format_date(char* dest, std::time_t t)
+{
+    static char const* const days =
+        "SunMonTueWedThuFriSat";
+    static char const* const months =
+        "JanFebMarAprMayJunJulAugSepOctNovDec";
+    auto const secs = static_cast<std::int64_t>(t);
+    auto z = secs >= 0 ? secs / 86400 : (secs - 86399) / 86400;
+    auto const rem = static_cast<int>(secs - z * 86400);
+    // 1970-01-01 was a Thursday
+    auto const wday = static_cast<int>(
+        z >= -4 ? (z + 4) % 7 : (z + 5) % 7 + 6);
+    // Civil date from days since the epoch
+    z += 719468;
+    auto const era = (z >= 0 ? z : z - 146096) / 146097;
+    auto const doe = z - era * 146097;
+    auto const yoe =
+        (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    auto const mp = (5 * doy + 2) / 153;
+    auto const day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    auto const month = static_cast<int>(mp < 10 ? mp + 2 : mp - 10);
+    auto const year = static_cast<int>(
+        yoe + era * 400 + (month < 2 ? 1 : 0));
+    auto p = dest;
+    std::memcpy(p, days + 3 * wday, 3);
+    p += 3;
+    *p++ = ',';
+    *p++ = ' ';
+    p = format_2digits(p, day);
+    *p++ = ' ';
+    std::memcpy(p, months + 3 * month, 3);
+    p += 3;
+    *p++ = ' ';
+    p = format_2digits(p, year / 100 % 100);
+    p = format_2digits(p, year % 100);
+    *p++ = ' ';
+    p = format_2digits(p, rem / 3600);
+    *p++ = ':';
+    p = format_2digits(p, rem / 60 % 60);
+    *p++ = ':';
+    p = format_2digits(p, rem % 60);
+    std::memcpy(p, " GMT", 4);
+    return p + 4;
+}
+
+/*  Holds the current date, formatted at most once per second.
+
+    The string is protected by a sequence lock. Readers copy
+    it without blocking, retrying only if they overlap the
+    once per second update. The first thread to notice the
+    change of second reformats it, others keep reading.
+*/
+template<class = void>
+class date_cache
+{
+    static std::size_t constexpr words = 4;
+
+    std::atomic<std::uint32_t> seq_;
+    std::atomic<std::int64_t> second_;
+    std::atomic<std::uint64_t> data_[words];
+
+    date_cache()
+        : seq_(0)
+        , second_(-1)
+    {
+        for(auto& w : data_)
+            w.store(0, std::memory_order_relaxed);
+    }
+
+public:
+    static
+    date_cache&
+    instance()
+    {
+        static date_cache c;
+        return c;
+    }
+
+    char*
+    copy(char* dest)
+    {
+        static_assert(sizeof(data_) >= date_size, "");
+        auto const now =
+            static_cast<std::int64_t>(std::time(nullptr));
+        if(now != second_.load(std::memory_order_acquire))
+            update(now);
+        std::uint64_t w[words];
+        for(;;)
+        {
+            auto const seq =
+                seq_.load(std::memory_order_acquire);
+            if(seq & 1)
+                continue;
+            for(std::size_t i = 0; i < words; ++i)
+                w[i] = data_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(seq_.load(std::memory_order_relaxed) == seq)
+                break;
+        }
+        std::memcpy(dest, w, date_size);
+        return dest + date_size;
+    }
+
+private:
+    void
+    update(std::int64_t now)
+    {
+        auto seq = seq_.load(std::memory_order_relaxed);
+        if((seq & 1) || ! seq_.compare_exchange_strong(
+                seq, seq + 1, std::memory_order_relaxed))
+            return;
+        std::atomic_thread_fence(std::memory_order_release);
+        std::uint64_t w[words] = {};
+        format_date(reinterpret_cast<char*>(w),
+            static_cast<std::time_t>(now));
+        for(std::size_t i = 0; i < words; ++i)
+            data_[i].store(w[i], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+        second_.store(now, std::memory_order_release);
+    }
+};
+
+} // detail
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_STATUS_LINE_HPP
+#define BEAST_HTTP_DETAIL_STATUS_LINE_HPP
+
+#include <beast/http/reason.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstring>
+#include <string>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+// Complete HTTP/1.1 status lines for each status code with
+// a known reason, such as "HTTP/1.1 200 OK\r\n", so that most
+// responses can be started with a single copy.
+template<class = void>
+class status_lines
+{
+    static int constexpr first = 100;
+    static int constexpr last = 599;
+
+    std::string s_;
+    boost::string_ref v_[last - first + 1];
+
+    status_lines()
+    {
+        std::size_t pos[last - first + 1][2] = {};
+        for(int status = first; status <= last; ++status)
+        {
+            auto const reason = reason_string(status);
+            // Not a standard status, such as "<unknown-status>"
+            if(reason[0] == '<')
+                continue;
+            auto& e = pos[status - first];
+            e[0] = s_.size();
+            s_.append("HTTP/1.1 ");
+            s_.append(std::to_string(status));
+            s_.append(" ");
+            s_.append(reason);
+            s_.append("\r\n");
+            e[1] = s_.size() - e[0];
+        }
+        for(int i = 0; i <= last - first; ++i)
+            if(pos[i][1] > 0)
+                v_[i] = boost::string_ref{
+                    s_.data() + pos[i][0], pos[i][1]};
+    }
+
+public:
+    static
+    status_lines const&
+    get()
+    {
+        static status_lines const t;
+        return t;
+    }
+
+    // Returns the status line for the status and reason,
+    // or an empty string if there is none.
+    boost::string_ref
+    find(int status, boost::string_ref reason) const
+    {
+        if(status < first || status > last)
+            return {};
+        auto const& v = v_[status - first];
+        // "HTTP/1.1 " status SP reason CRLF
+        if(v.size() != 13 + reason.size() + 2 ||
+                std::memcmp(v.data() + 13,
+                    reason.data(), reason.size()) != 0)
+            return {};
+        return v;
+    }
+};
+
+} // detail
+} // http
+} // beast
+
+#endif
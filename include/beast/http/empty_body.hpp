@@ -56,9 +56,8 @@ private:
         }
 
         template<class WriteFunction>
-        boost::tribool
-        write(resume_context&&, error_code&,
-            WriteFunction&& wf) noexcept
+        bool
+        write(error_code&, WriteFunction&& wf) noexcept
         {
             wf(boost::asio::null_buffers{});
             return true;
@@ -0,0 +1,241 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_HEADER_SERIALIZER_HPP
+#define BEAST_HTTP_HEADER_SERIALIZER_HPP
+
+#include <beast/http/message.hpp>
+#include <beast/core/detail/empty_base_optimization.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace beast {
+namespace http {
+
+/** Serializes the headers of HTTP/1 messages into contiguous storage.
+
+    This object converts the start line and header fields of a
+    message to the HTTP/1 wire format. The exact size of the result
+    is computed before anything is written, and the octets are placed
+    in a single contiguous buffer. No memory is allocated while
+    formatting, including for numbers such as the version and status.
+    HTTP/1.1 responses with a standard status and reason are started
+    by copying a preformatted status line.
+
+    The storage is either provided by the caller at construction, or
+    obtained from the allocator. When a message does not fit, larger
+    storage is allocated, and it is kept for subsequent messages. An
+    object of this type may be kept with a connection and reused for
+    every message written on it, so that after the first few messages
+    serializing headers performs no allocations at all.
+
+    @tparam Allocator The allocator to use for managing memory.
+*/
+template<class Allocator>
+class basic_header_serializer
+#if ! GENERATING_DOCS
+    : private beast::detail::empty_base_optimization<
+        typename std::allocator_traits<Allocator>::
+            template rebind_alloc<char>>
+#endif
+{
+public:
+#if GENERATING_DOCS
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+#else
+    using allocator_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<char>;
+#endif
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    char* p_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t size_ = 0;
+    bool owned_ = false;
+    bool date_ = false;
+
+public:
+    /// Destructor.
+    ~basic_header_serializer();
+
+    /** Construct a header serializer.
+
+        No memory is allocated until the first message
+        is serialized.
+
+        @param alloc The allocator to use.
+    */
+    explicit
+    basic_header_serializer(
+        Allocator const& alloc = allocator_type{});
+
+    /** Construct a header serializer using caller provided storage.
+
+        Messages are serialized into the provided storage while they
+        fit. Otherwise, storage is obtained from the allocator.
+
+        @param data A pointer to the storage. Ownership is not
+        transferred, the storage must remain valid for the lifetime
+        of the serializer.
+
+        @param size The size of the storage, in bytes.
+
+        @param alloc The allocator to use.
+    */
+    basic_header_serializer(void* data, std::size_t size,
+        Allocator const& alloc = allocator_type{});
+
+    /** Move constructor.
+
+        After the move, the moved-from object has no storage.
+    */
+    basic_header_serializer(basic_header_serializer&& other);
+
+    /// Copy constructor (disallowed).
+    basic_header_serializer(basic_header_serializer const&) = delete;
+
+    /// Copy assignment (disallowed).
+    basic_header_serializer& operator=(
+        basic_header_serializer const&) = delete;
+
+    /// Returns a copy of the associated allocator.
+    allocator_type
+    get_allocator() const
+    {
+        return this->member();
+    }
+
+    /// Returns the size of the available storage.
+    std::size_t
+    capacity() const
+    {
+        return capacity_;
+    }
+
+    /// Returns the size of the serialized headers.
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** Returns the serialized headers.
+
+        The buffer remains valid until the next call to
+        @ref serialize or @ref clear.
+    */
+    boost::asio::const_buffers_1
+    data() const
+    {
+        return boost::asio::const_buffers_1(p_, size_);
+    }
+
+    /// Returns `true` if a Date field is added to responses.
+    bool
+    insert_date() const
+    {
+        return date_;
+    }
+
+    /** Set whether a Date field is added to responses.
+
+        When enabled, a response whose headers do not contain
+        a Date field is serialized with one following the status
+        line, holding the value of @ref current_date. Requests are
+        not affected. This is disabled by default.
+    */
+    void
+    insert_date(bool v)
+    {
+        date_ = v;
+    }
+
+    /// Discard the serialized headers, keeping the storage.
+    void
+    clear()
+    {
+        size_ = 0;
+    }
+
+    /** Returns the size of the serialized headers of a message.
+
+        The size includes the start line, each field, and the
+        empty line which ends the headers. It does not include
+        a Date field added because of @ref insert_date.
+    */
+    template<bool isRequest, class Body, class Headers>
+    static
+    std::size_t
+    serialized_size(message<isRequest, Body, Headers> const& msg);
+
+    /** Serialize the headers of a message.
+
+        Any previously serialized headers are replaced. Upon
+        return, @ref data holds the start line and fields of
+        the message, followed by the empty line. The version,
+        and the status of a response, must not be negative.
+
+        @throws std::bad_alloc if storage could not be allocated.
+    */
+    template<bool isRequest, class Body, class Headers>
+    void
+    serialize(message<isRequest, Body, Headers> const& msg);
+
+private:
+    void
+    reserve(std::size_t n);
+
+    template<class Body, class Headers>
+    bool
+    needs_date(message<true, Body, Headers> const&) const
+    {
+        return false;
+    }
+
+    template<class Body, class Headers>
+    bool
+    needs_date(message<false, Body, Headers> const& msg) const
+    {
+        return date_ && ! msg.headers.exists("Date");
+    }
+
+    template<class Body, class Headers>
+    static
+    std::size_t
+    start_line_size(message<true, Body, Headers> const& msg);
+
+    template<class Body, class Headers>
+    static
+    std::size_t
+    start_line_size(message<false, Body, Headers> const& msg);
+
+    template<class Body, class Headers>
+    static
+    char*
+    write_start_line(char* p, message<true, Body, Headers> const& msg);
+
+    template<class Body, class Headers>
+    static
+    char*
+    write_start_line(char* p, message<false, Body, Headers> const& msg);
+};
+
+/// A header serializer which uses the default allocator.
+using header_serializer =
+    basic_header_serializer<std::allocator<char>>;
+
+} // http
+} // beast
+
+#include <beast/http/impl/header_serializer.ipp>
+
+#endif
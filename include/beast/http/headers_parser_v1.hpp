@@ -11,6 +11,7 @@
 #include <beast/http/basic_parser_v1.hpp>
 #include <beast/http/concepts.hpp>
 #include <beast/http/message.hpp>
+#include <beast/http/verb.hpp>
 #include <beast/core/error.hpp>
 #include <boost/assert.hpp>
 #include <boost/optional.hpp>
@@ -172,7 +173,10 @@ private:
 
     void on_request_or_response(std::true_type)
     {
-        h_.method = std::move(this->method_);
+        h_.verb = string_to_verb(this->method_);
+        if(h_.verb == verb::unknown)
+            h_.method = std::move(this->method_);
+        this->method_.clear();
         h_.url = std::move(this->uri_);
     }
 
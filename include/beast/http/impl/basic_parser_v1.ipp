@@ -43,18 +43,18 @@
 namespace beast {
 namespace http {
 
-template<bool isRequest, class Derived>
-basic_parser_v1<isRequest, Derived>::
+template<bool isRequest, class Derived, class Policy>
+basic_parser_v1<isRequest, Derived, Policy>::
 basic_parser_v1()
 {
     init();
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
 template<class OtherDerived>
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 basic_parser_v1(basic_parser_v1<
-        isRequest, OtherDerived> const& other)
+        isRequest, OtherDerived, Policy> const& other)
     : h_max_(other.h_max_)
     , h_left_(other.h_left_)
     , b_max_(other.b_max_)
@@ -73,12 +73,12 @@ basic_parser_v1(basic_parser_v1<
     BOOST_ASSERT(! other.cb_);
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
 template<class OtherDerived>
 auto
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 operator=(basic_parser_v1<
-    isRequest, OtherDerived> const& other) ->
+    isRequest, OtherDerived, Policy> const& other) ->
         basic_parser_v1&
 {
     BOOST_ASSERT(! other.cb_);
@@ -99,9 +99,9 @@ operator=(basic_parser_v1<
     return *this;
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
 bool
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 keep_alive() const
 {
     if(http_major_ >= 1 && http_minor_ >= 1)
@@ -117,13 +117,13 @@ keep_alive() const
     return ! needs_eof();
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
 template<class ConstBufferSequence>
 typename std::enable_if<
     ! std::is_convertible<ConstBufferSequence,
         boost::asio::const_buffer>::value,
             std::size_t>::type
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 write(ConstBufferSequence const& buffers, error_code& ec)
 {
     static_assert(is_ConstBufferSequence<ConstBufferSequence>::value,
@@ -131,16 +131,21 @@ write(ConstBufferSequence const& buffers, error_code& ec)
     std::size_t used = 0;
     for(auto const& buffer : buffers)
     {
-        used += write(buffer, ec);
+        auto const n = write(buffer, ec);
+        used += n;
         if(ec)
             break;
+        // Stop at the end of a message, so that octets
+        // belonging to a pipelined message are not consumed.
+        if(n > 0 && complete())
+            break;
     }
     return used;
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
 std::size_t
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 write(boost::asio::const_buffer const& buffer, error_code& ec)
 {
     using beast::http::detail::is_digit;
@@ -473,7 +478,11 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             case 'c': pos_ = 0; fs_ = h_C; break;
             case 'p': pos_ = 0; fs_ = h_matching_proxy_connection; break;
             case 't': pos_ = 0; fs_ = h_matching_transfer_encoding; break;
-            case 'u': pos_ = 0; fs_ = h_matching_upgrade; break;
+            case 'u':
+                pos_ = 0;
+                fs_ = Policy::upgrade ?
+                    h_matching_upgrade : h_general;
+                break;
             default:
                 fs_ = h_general;
                 break;
@@ -569,6 +578,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             }
             if(ch == ':')
             {
+                if(! Policy::chunked && fs_ == h_transfer_encoding)
+                    return err(parse_error::illegal_transfer_encoding);
                 if(cb(nullptr))
                     return errc();
                 s_ = s_header_value0;
@@ -637,7 +648,9 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                         break;
                     case 'u':
                         pos_ = 0;
-                        fs_ = h_matching_connection_upgrade;
+                        fs_ = Policy::upgrade ?
+                            h_matching_connection_upgrade :
+                                h_connection_token;
                         break;
                     default:
                         if(ch == ' ' || ch == '\t' || ch == ',')
@@ -843,6 +856,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
         case s_header_value0_almost_done:
             if(ch == ' ' || ch == '\t')
             {
+                if(! Policy::obs_fold)
+                    return err(parse_error::illegal_obs_fold);
                 s_ = s_header_value0;
                 break;
             }
@@ -866,6 +881,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
         case s_header_value_almost_done:
             if(ch == ' ' || ch == '\t')
             {
+                if(! Policy::obs_fold)
+                    return err(parse_error::illegal_obs_fold);
                 switch(fs_)
                 {
                 case h_matching_connection_keep_alive:
@@ -946,7 +963,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             }
             if((flags_ & parse_flag::chunked) && (flags_ & parse_flag::contentlength))
                 return err(parse_error::illegal_content_length);
-            upgrade_ = ((flags_ & (parse_flag::upgrade | parse_flag::connection_upgrade)) ==
+            upgrade_ = Policy::upgrade && ((flags_ & (parse_flag::upgrade | parse_flag::connection_upgrade)) ==
                 (parse_flag::upgrade | parse_flag::connection_upgrade)) /*|| method == "connect"*/;
             call_on_headers(ec);
             if(ec)
@@ -1002,7 +1019,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             if(ec)
                 return errc();
             bool const hasBody =
-                (flags_ & parse_flag::chunked) || (content_length_ > 0 &&
+                (Policy::chunked && (flags_ & parse_flag::chunked)) || (content_length_ > 0 &&
                     content_length_ != no_content_length);
             if(upgrade_ && (/*method == "connect" ||*/ (flags_ & parse_flag::skipbody) || ! hasBody))
             {
@@ -1012,13 +1029,15 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             {
                 s_ = s_complete;
             }
-            else if(flags_ & parse_flag::chunked)
+            else if(Policy::chunked && (flags_ & parse_flag::chunked))
             {
                 s_ = s_chunk_size0;
                 break;
             }
             else if(content_length_ != no_content_length)
             {
+                if(b_max_ && content_length_ > b_left_)
+                    return err(parse_error::body_too_big);
                 s_ = s_body_identity0;
                 break;
             }
@@ -1209,9 +1228,35 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
     return used();
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
+void
+basic_parser_v1<isRequest, Derived, Policy>::
+consume_body(std::size_t n, error_code& ec)
+{
+    BOOST_ASSERT(n > 0 && n <= body_remaining());
+    if(b_max_ && n > b_left_)
+    {
+        s_ = s_dead;
+        ec = parse_error::body_too_big;
+        return;
+    }
+    b_left_ -= n;
+    content_length_ -= n;
+    if(content_length_ > 0)
+        return;
+    cb_ = nullptr;
+    call_on_complete(ec);
+    if(ec)
+    {
+        s_ = s_dead;
+        return;
+    }
+    s_ = s_restart;
+}
+
+template<bool isRequest, class Derived, class Policy>
 void
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 write_eof(error_code& ec)
 {
     switch(s_)
@@ -1243,9 +1288,9 @@ write_eof(error_code& ec)
     }
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
 void
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 reset()
 {
     cb_ = nullptr;
@@ -1254,17 +1299,17 @@ reset()
     reset(std::integral_constant<bool, isRequest>{});
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
 bool
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 needs_eof(std::true_type) const
 {
     return false;
 }
 
-template<bool isRequest, class Derived>
+template<bool isRequest, class Derived, class Policy>
 bool
-basic_parser_v1<isRequest, Derived>::
+basic_parser_v1<isRequest, Derived, Policy>::
 needs_eof(std::false_type) const
 {
     // See RFC 2616 section 4.4
@@ -1274,7 +1319,7 @@ needs_eof(std::false_type) const
         flags_ & parse_flag::skipbody)  // response to a HEAD request
         return false;
 
-    if((flags_ & parse_flag::chunked) ||
+    if((Policy::chunked && (flags_ & parse_flag::chunked)) ||
         content_length_ != no_content_length)
         return false;
 
@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_HEADER_SERIALIZER_IPP
+#define BEAST_HTTP_IMPL_HEADER_SERIALIZER_IPP
+
+#include <beast/http/date.hpp>
+#include <beast/http/verb.hpp>
+#include <beast/http/detail/status_line.hpp>
+#include <beast/core/detail/format_uint.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+inline
+char*
+copy_chars(char* p, char const* s, std::size_t n)
+{
+    std::memcpy(p, s, n);
+    return p + n;
+}
+
+template<class String>
+char*
+copy_chars(char* p, String const& s)
+{
+    return copy_chars(p, s.data(), s.size());
+}
+
+} // detail
+
+template<class Allocator>
+basic_header_serializer<Allocator>::
+~basic_header_serializer()
+{
+    if(owned_)
+        alloc_traits::deallocate(
+            this->member(), p_, capacity_);
+}
+
+template<class Allocator>
+basic_header_serializer<Allocator>::
+basic_header_serializer(Allocator const& alloc)
+    : beast::detail::empty_base_optimization<
+        allocator_type>(alloc)
+{
+}
+
+template<class Allocator>
+basic_header_serializer<Allocator>::
+basic_header_serializer(void* data, std::size_t size,
+        Allocator const& alloc)
+    : beast::detail::empty_base_optimization<
+        allocator_type>(alloc)
+    , p_(reinterpret_cast<char*>(data))
+    , capacity_(size)
+{
+}
+
+template<class Allocator>
+basic_header_serializer<Allocator>::
+basic_header_serializer(basic_header_serializer&& other)
+    : beast::detail::empty_base_optimization<
+        allocator_type>(std::move(other.member()))
+    , p_(other.p_)
+    , capacity_(other.capacity_)
+    , size_(other.size_)
+    , owned_(other.owned_)
+    , date_(other.date_)
+{
+    other.p_ = nullptr;
+    other.capacity_ = 0;
+    other.size_ = 0;
+    other.owned_ = false;
+}
+
+template<class Allocator>
+template<bool isRequest, class Body, class Headers>
+std::size_t
+basic_header_serializer<Allocator>::
+serialized_size(message<isRequest, Body, Headers> const& msg)
+{
+    auto n = start_line_size(msg);
+    for(auto const& field : msg.headers)
+        n += field.name().size() + 2 +
+            field.value().size() + 2;
+    return n + 2;
+}
+
+template<class Allocator>
+template<bool isRequest, class Body, class Headers>
+void
+basic_header_serializer<Allocator>::
+serialize(message<isRequest, Body, Headers> const& msg)
+{
+    auto const date = needs_date(msg);
+    // "Date: " date CRLF
+    auto const n = serialized_size(msg) +
+        (date ? 6 + date_size + 2 : 0);
+    size_ = 0;
+    reserve(n);
+    auto p = write_start_line(p_, msg);
+    if(date)
+    {
+        p = detail::copy_chars(p, "Date: ", 6);
+        p = current_date(p);
+        p = detail::copy_chars(p, "\r\n", 2);
+    }
+    for(auto const& field : msg.headers)
+    {
+        p = detail::copy_chars(p, field.name());
+        p = detail::copy_chars(p, ": ", 2);
+        p = detail::copy_chars(p, field.value());
+        p = detail::copy_chars(p, "\r\n", 2);
+    }
+    p = detail::copy_chars(p, "\r\n", 2);
+    BOOST_ASSERT(static_cast<std::size_t>(p - p_) == n);
+    size_ = n;
+}
+
+template<class Allocator>
+void
+basic_header_serializer<Allocator>::
+reserve(std::size_t n)
+{
+    if(n <= capacity_)
+        return;
+    auto const p = alloc_traits::allocate(this->member(), n);
+    if(owned_)
+        alloc_traits::deallocate(
+            this->member(), p_, capacity_);
+    p_ = p;
+    capacity_ = n;
+    owned_ = true;
+}
+
+template<class Allocator>
+template<class Body, class Headers>
+std::size_t
+basic_header_serializer<Allocator>::
+start_line_size(message<true, Body, Headers> const& msg)
+{
+    using beast::detail::uint_digits;
+    BOOST_ASSERT(msg.version >= 0);
+    auto const method = msg.verb != verb::unknown ?
+        method_string(msg.verb).size() : msg.method.size();
+    // METHOD SP url SP "HTTP/" major "." minor CRLF
+    return method + 1 + msg.url.size() + 6 +
+        uint_digits(msg.version / 10) + 1 +
+        uint_digits(msg.version % 10) + 2;
+}
+
+template<class Allocator>
+template<class Body, class Headers>
+std::size_t
+basic_header_serializer<Allocator>::
+start_line_size(message<false, Body, Headers> const& msg)
+{
+    using beast::detail::uint_digits;
+    BOOST_ASSERT(msg.version >= 0);
+    BOOST_ASSERT(msg.status >= 0);
+    // "HTTP/" major "." minor SP status SP reason CRLF
+    return 5 +
+        uint_digits(msg.version / 10) + 1 +
+        uint_digits(msg.version % 10) + 1 +
+        uint_digits(msg.status) + 1 +
+        msg.reason.size() + 2;
+}
+
+template<class Allocator>
+template<class Body, class Headers>
+char*
+basic_header_serializer<Allocator>::
+write_start_line(char* p, message<true, Body, Headers> const& msg)
+{
+    using beast::detail::format_uint;
+    if(msg.verb != verb::unknown)
+        p = detail::copy_chars(p, method_string(msg.verb));
+    else
+        p = detail::copy_chars(p, msg.method);
+    *p++ = ' ';
+    p = detail::copy_chars(p, msg.url);
+    p = detail::copy_chars(p, " HTTP/", 6);
+    p = format_uint(p, msg.version / 10);
+    *p++ = '.';
+    p = format_uint(p, msg.version % 10);
+    return detail::copy_chars(p, "\r\n", 2);
+}
+
+template<class Allocator>
+template<class Body, class Headers>
+char*
+basic_header_serializer<Allocator>::
+write_start_line(char* p, message<false, Body, Headers> const& msg)
+{
+    using beast::detail::format_uint;
+    if(msg.version == 11)
+    {
+        auto const line = detail::status_lines<>::get().find(
+            msg.status, msg.reason);
+        if(! line.empty())
+            return detail::copy_chars(p, line);
+    }
+    p = detail::copy_chars(p, "HTTP/", 5);
+    p = format_uint(p, msg.version / 10);
+    *p++ = '.';
+    p = format_uint(p, msg.version % 10);
+    *p++ = ' ';
+    p = format_uint(p, msg.status);
+    *p++ = ' ';
+    p = detail::copy_chars(p, msg.reason);
+    return detail::copy_chars(p, "\r\n", 2);
+}
+
+} // http
+} // beast
+
+#endif
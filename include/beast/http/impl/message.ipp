@@ -12,6 +12,7 @@
 #include <beast/http/concepts.hpp>
 #include <beast/http/rfc7230.hpp>
 #include <beast/core/detail/ci_char_traits.hpp>
+#include <beast/core/detail/format_uint.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/assert.hpp>
 #include <boost/optional.hpp>
@@ -113,6 +114,18 @@ prepare_content_length(prepare_info& pi,
     pi.content_length = boost::none;
 }
 
+template<bool isRequest, class Body, class Headers>
+void
+insert_content_length(message<isRequest, Body, Headers>& msg,
+    std::uint64_t n)
+{
+    char buf[beast::detail::max_uint_digits];
+    auto const end = beast::detail::format_uint(buf, n);
+    msg.headers.insert("Content-Length",
+        boost::string_ref{buf,
+            static_cast<std::size_t>(end - buf)});
+}
+
 } // detail
 
 template<
@@ -160,10 +173,12 @@ prepare(message<isRequest, Body, Headers>& msg,
                 {
                     using beast::detail::ci_equal;
                     if(*pi.content_length > 0 ||
-                        ci_equal(msg.method, "POST"))
+                        msg.verb == verb::post || (
+                            msg.verb == verb::unknown &&
+                            ci_equal(msg.method, "POST")))
                     {
-                        msg.headers.insert("Content-Length",
-                            std::to_string(*pi.content_length));
+                        detail::insert_content_length(
+                            msg, *pi.content_length);
                     }
                 }
 
@@ -175,8 +190,8 @@ prepare(message<isRequest, Body, Headers>& msg,
                         msg.status != 204 &&
                         msg.status != 304)
                     {
-                        msg.headers.insert("Content-Length",
-                            std::to_string(*pi.content_length));
+                        detail::insert_content_length(
+                            msg, *pi.content_length);
                     }
                 }
             };
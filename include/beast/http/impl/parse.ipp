@@ -10,7 +10,7 @@
 
 #include <beast/http/concepts.hpp>
 #include <beast/core/bind_handler.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <boost/assert.hpp>
 
@@ -19,37 +19,105 @@ namespace http {
 
 namespace detail {
 
+template<class Parser, class = beast::detail::void_t<>>
+struct has_direct_body : std::false_type {};
+
+template<class Parser>
+struct has_direct_body<Parser, beast::detail::void_t<decltype(
+    std::declval<Parser&>().body_remaining(),
+    std::declval<Parser&>().prepare_body(std::size_t{}),
+    std::declval<Parser&>().commit_body(std::size_t{},
+        std::declval<error_code&>())
+            )> > : std::true_type {};
+
+// Returns the number of octets to read straight into the
+// body storage, or zero if the stream buffer must be used.
+template<class DynamicBuffer, class Parser>
+std::size_t
+direct_body_size(DynamicBuffer const&, Parser const&,
+    std::false_type)
+{
+    return 0;
+}
+
+template<class DynamicBuffer, class Parser>
+std::size_t
+direct_body_size(DynamicBuffer const& dynabuf,
+    Parser const& parser, std::true_type)
+{
+    if(dynabuf.size() > 0)
+        return 0;
+    auto const n = parser.body_remaining();
+    if(n > 65536)
+        return 65536;
+    return static_cast<std::size_t>(n);
+}
+
+template<class Parser>
+void
+commit_body(Parser&, std::size_t, error_code&, std::false_type)
+{
+}
+
+template<class Parser>
+void
+commit_body(Parser& parser, std::size_t bytes_transferred,
+    error_code& ec, std::true_type)
+{
+    if(ec)
+    {
+        // Release the prepared storage
+        error_code ignored;
+        parser.commit_body(0, ignored);
+        return;
+    }
+    parser.commit_body(bytes_transferred, ec);
+}
+
+template<class SyncReadStream, class Parser>
+std::size_t
+read_body_some(SyncReadStream&, Parser&,
+    std::size_t, error_code&, std::false_type)
+{
+    return 0;
+}
+
+template<class SyncReadStream, class Parser>
+std::size_t
+read_body_some(SyncReadStream& stream, Parser& parser,
+    std::size_t n, error_code& ec, std::true_type)
+{
+    auto const bytes_transferred =
+        stream.read_some(parser.prepare_body(n), ec);
+    commit_body(parser, bytes_transferred, ec, std::true_type{});
+    return bytes_transferred;
+}
+
 template<class Stream,
     class DynamicBuffer, class Parser, class Handler>
 class parse_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
-
     struct data
     {
         Stream& s;
         DynamicBuffer& db;
         Parser& p;
-        Handler h;
         bool started = false;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_, Stream& s_,
+        data(Handler& h, Stream& s_,
                 DynamicBuffer& sb_, Parser& p_)
             : s(s_)
             , db(sb_)
             , p(p_)
-            , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     parse_op(parse_op&&) = default;
@@ -57,9 +125,8 @@ public:
 
     template<class DeducedHandler, class... Args>
     parse_op(DeducedHandler&& h, Stream& s, Args&&... args)
-        : d_(std::allocate_shared<data>(alloc_type{h},
-            std::forward<DeducedHandler>(h), s,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            s, std::forward<Args>(args)...)
     {
         (*this)(error_code{}, 0, false);
     }
@@ -68,12 +135,29 @@ public:
     operator()(error_code ec,
         std::size_t bytes_transferred, bool again = true);
 
+private:
+    using direct = typename has_direct_body<Parser>::type;
+
+    void
+    read_body(std::size_t, std::false_type)
+    {
+    }
+
+    void
+    read_body(std::size_t n, std::true_type)
+    {
+        auto& d = *d_;
+        d.s.async_read_some(
+            d.p.prepare_body(n), std::move(*this));
+    }
+
+public:
     friend
     void* asio_handler_allocate(
         std::size_t size, parse_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -81,7 +165,7 @@ public:
         void* p, std::size_t size, parse_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -95,7 +179,7 @@ public:
     void asio_handler_invoke(Function&& f, parse_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -139,12 +223,23 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
         }
 
         case 1:
+        {
             // read
+            auto const n =
+                direct_body_size(d.db, d.p, direct{});
+            if(n > 0)
+            {
+                // read into the body
+                d.state = 3;
+                read_body(n, direct{});
+                return;
+            }
             d.state = 2;
             d.s.async_read_some(d.db.prepare(
                 read_size_helper(d.db, 65536)),
                     std::move(*this));
             return;
+        }
 
         // got data
         case 2:
@@ -191,9 +286,31 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
             d.state = 1;
             break;
         }
+
+        // got body data
+        case 3:
+            commit_body(d.p, bytes_transferred, ec, direct{});
+            if(ec == boost::asio::error::eof)
+            {
+                // Caller will see eof on next read.
+                ec = {};
+                d.p.write_eof(ec);
+                BOOST_ASSERT(ec || d.p.complete());
+                // call handler
+                d.state = 99;
+                break;
+            }
+            if(ec || d.p.complete())
+            {
+                // call handler
+                d.state = 99;
+                break;
+            }
+            d.state = 1;
+            break;
         }
     }
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // detail
@@ -228,6 +345,8 @@ parse(SyncReadStream& stream, DynamicBuffer& dynabuf,
         "DynamicBuffer requirements not met");
     static_assert(is_Parser<Parser>::value,
         "Parser requirements not met");
+    using direct = typename
+        detail::has_direct_body<Parser>::type;
     bool started = false;
     for(;;)
     {
@@ -240,9 +359,15 @@ parse(SyncReadStream& stream, DynamicBuffer& dynabuf,
             started = true;
         if(parser.complete())
             break;
-        dynabuf.commit(stream.read_some(
-            dynabuf.prepare(read_size_helper(
-                dynabuf, 65536)), ec));
+        auto const n = detail::direct_body_size(
+            dynabuf, parser, direct{});
+        if(n > 0)
+            detail::read_body_some(
+                stream, parser, n, ec, direct{});
+        else
+            dynabuf.commit(stream.read_some(
+                dynabuf.prepare(read_size_helper(
+                    dynabuf, 65536)), ec));
         if(ec && ec != boost::asio::error::eof)
             return;
         if(ec == boost::asio::error::eof)
@@ -53,6 +53,8 @@ public:
         case parse_error::headers_too_big: return "headers size limit exceeded";
         case parse_error::body_too_big: return "body size limit exceeded";
         case parse_error::short_read: return "unexpected end of data";
+        case parse_error::illegal_obs_fold: return "obs-fold not allowed";
+        case parse_error::illegal_transfer_encoding: return "Transfer-Encoding not allowed";
         default:
             return "parse error";
         }
@@ -0,0 +1,506 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_PIPELINE_IPP
+#define BEAST_HTTP_IMPL_PIPELINE_IPP
+
+#include <beast/http/concepts.hpp>
+#include <beast/http/parse.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/http/write.hpp>
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/handler_ptr.hpp>
+#include <beast/core/stream_concepts.hpp>
+#include <beast/core/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/assert.hpp>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+// Adapts a DynamicBuffer to SyncWriteStream, so
+// that messages may be serialized into memory.
+template<class DynamicBuffer>
+class dynabuf_SyncStream
+{
+    DynamicBuffer& dynabuf_;
+
+public:
+    explicit
+    dynabuf_SyncStream(DynamicBuffer& dynabuf)
+        : dynabuf_(dynabuf)
+    {
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_some(ConstBufferSequence const& buffers)
+    {
+        error_code ec;
+        auto const n = write_some(buffers, ec);
+        if(ec)
+            throw system_error{ec};
+        return n;
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_some(ConstBufferSequence const& buffers,
+        error_code&)
+    {
+        using boost::asio::buffer_copy;
+        using boost::asio::buffer_size;
+        auto const n = buffer_copy(dynabuf_.prepare(
+            buffer_size(buffers)), buffers);
+        dynabuf_.commit(n);
+        return n;
+    }
+};
+
+// Serialize messages in order, stopping after
+// the first message which indicates a close.
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write_batch(DynamicBuffer& dynabuf, std::vector<
+    message<isRequest, Body, Headers>, Allocator> const& msgs,
+        error_code& ec)
+{
+    dynabuf_SyncStream<DynamicBuffer> ds{dynabuf};
+    // One serializer for the batch, so its storage is reused
+    header_serializer hs;
+    for(auto const& msg : msgs)
+    {
+        beast::http::write(ds, msg, hs, ec);
+        if(ec)
+            return;
+    }
+}
+
+template<class Stream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class Handler>
+class read_pipelined_op
+{
+    using parser_type =
+        parser_v1<isRequest, Body, Headers>;
+
+    using message_type =
+        message<isRequest, Body, Headers>;
+
+    struct data
+    {
+        Stream& s;
+        DynamicBuffer& db;
+        std::vector<message_type, Allocator>& msgs;
+        parser_type p;
+        bool cont;
+        int state = 0;
+
+        data(Handler& h, Stream& s_, DynamicBuffer& sb_,
+                std::vector<message_type, Allocator>& msgs_)
+            : s(s_)
+            , db(sb_)
+            , msgs(msgs_)
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    handler_ptr<data, Handler> d_;
+
+public:
+    read_pipelined_op(read_pipelined_op&&) = default;
+    read_pipelined_op(read_pipelined_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    read_pipelined_op(DeducedHandler&& h, Stream& s, Args&&... args)
+        : d_(std::forward<DeducedHandler>(h),
+            s, std::forward<Args>(args)...)
+    {
+        (*this)(error_code{}, false);
+    }
+
+    void
+    operator()(error_code ec, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, read_pipelined_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_.handler());
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, read_pipelined_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_.handler());
+    }
+
+    friend
+    bool asio_handler_is_continuation(read_pipelined_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, read_pipelined_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_.handler());
+    }
+};
+
+template<class Stream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class Handler>
+void
+read_pipelined_op<Stream, DynamicBuffer,
+    isRequest, Body, Headers, Allocator, Handler>::
+operator()(error_code ec, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(! ec && d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            d.state = 1;
+            async_parse(d.s, d.db, d.p, std::move(*this));
+            return;
+
+        case 1:
+        {
+            // call handler
+            d.state = 99;
+            d.msgs.push_back(d.p.release());
+            if(d.p.keep_alive() && ! d.p.upgrade())
+            {
+                // Errors are seen by the next read
+                error_code ignored;
+                read_buffered(d.db, d.msgs, ignored);
+            }
+            break;
+        }
+        }
+    }
+    d_.invoke(ec);
+}
+
+template<class Stream, class Handler>
+class write_pipelined_op
+{
+    struct data
+    {
+        Stream& s;
+        streambuf sb;
+        error_code close;
+        bool cont;
+        int state = 0;
+
+        data(Handler& h, Stream& s_)
+            : s(s_)
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    handler_ptr<data, Handler> d_;
+
+public:
+    write_pipelined_op(write_pipelined_op&&) = default;
+    write_pipelined_op(write_pipelined_op const&) = default;
+
+    template<class DeducedHandler, class Messages>
+    write_pipelined_op(DeducedHandler&& h,
+            Stream& s, Messages const& msgs)
+        : d_(std::forward<DeducedHandler>(h), s)
+    {
+        auto& d = *d_;
+        write_batch(d.sb, msgs, d.close);
+        (*this)(error_code{}, 0, false);
+    }
+
+    void
+    operator()(error_code ec,
+        std::size_t bytes_transferred, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, write_pipelined_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_.handler());
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, write_pipelined_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_.handler());
+    }
+
+    friend
+    bool asio_handler_is_continuation(write_pipelined_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, write_pipelined_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_.handler());
+    }
+};
+
+template<class Stream, class Handler>
+void
+write_pipelined_op<Stream, Handler>::
+operator()(error_code ec, std::size_t, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(! ec && d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            if(d.close && d.close != boost::asio::error::eof)
+            {
+                // call handler
+                d.state = 99;
+                d.s.get_io_service().post(bind_handler(
+                    std::move(*this), d.close, 0));
+                return;
+            }
+            d.state = 1;
+            boost::asio::async_write(d.s,
+                d.sb.data(), std::move(*this));
+            return;
+
+        case 1:
+            // call handler
+            d.state = 99;
+            ec = d.close;
+            break;
+        }
+    }
+    d_.invoke(ec);
+}
+
+} // detail
+
+//------------------------------------------------------------------------------
+
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+std::size_t
+read_buffered(DynamicBuffer& dynabuf, std::vector<
+    message<isRequest, Body, Headers>, Allocator>& msgs,
+        error_code& ec)
+{
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_reader<Body>::value,
+        "Body has no reader");
+    static_assert(is_Reader<typename Body::reader,
+        message<isRequest, Body, Headers>>::value,
+            "Reader requirements not met");
+    std::size_t n = 0;
+    while(dynabuf.size() > 0)
+    {
+        parser_v1<isRequest, Body, Headers> p;
+        auto const used = p.write(dynabuf.data(), ec);
+        if(ec || ! p.complete())
+            break;
+        dynabuf.consume(used);
+        msgs.push_back(p.release());
+        ++n;
+        if(! p.keep_alive() || p.upgrade())
+            break;
+    }
+    return n;
+}
+
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_pipelined(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_reader<Body>::value,
+        "Body has no reader");
+    static_assert(is_Reader<typename Body::reader,
+        message<isRequest, Body, Headers>>::value,
+            "Reader requirements not met");
+    error_code ec;
+    read_pipelined(stream, dynabuf, msgs, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_pipelined(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs,
+        error_code& ec)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_reader<Body>::value,
+        "Body has no reader");
+    static_assert(is_Reader<typename Body::reader,
+        message<isRequest, Body, Headers>>::value,
+            "Reader requirements not met");
+    parser_v1<isRequest, Body, Headers> p;
+    beast::http::parse(stream, dynabuf, p, ec);
+    if(ec)
+        return;
+    BOOST_ASSERT(p.complete());
+    msgs.push_back(p.release());
+    if(! p.keep_alive() || p.upgrade())
+        return;
+    // Errors are seen by the next read
+    error_code ignored;
+    read_buffered(dynabuf, msgs, ignored);
+}
+
+template<class AsyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class ReadHandler>
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+async_read_pipelined(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs,
+        ReadHandler&& handler)
+{
+    static_assert(is_AsyncReadStream<AsyncReadStream>::value,
+        "AsyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_reader<Body>::value,
+        "Body has no reader");
+    static_assert(is_Reader<typename Body::reader,
+        message<isRequest, Body, Headers>>::value,
+            "Reader requirements not met");
+    beast::async_completion<ReadHandler,
+        void(error_code)> completion(handler);
+    detail::read_pipelined_op<AsyncReadStream, DynamicBuffer,
+        isRequest, Body, Headers, Allocator, decltype(
+            completion.handler)>{completion.handler,
+                stream, dynabuf, msgs};
+    return completion.result.get();
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write_pipelined(SyncWriteStream& stream, std::vector<
+    message<isRequest, Body, Headers>, Allocator> const& msgs)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    error_code ec;
+    write_pipelined(stream, msgs, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write_pipelined(SyncWriteStream& stream, std::vector<
+    message<isRequest, Body, Headers>, Allocator> const& msgs,
+        error_code& ec)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    streambuf sb;
+    error_code close;
+    detail::write_batch(sb, msgs, close);
+    if(close && close != boost::asio::error::eof)
+    {
+        ec = close;
+        return;
+    }
+    boost::asio::write(stream, sb.data(), ec);
+    if(ec)
+        return;
+    ec = close;
+}
+
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class WriteHandler>
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+async_write_pipelined(AsyncWriteStream& stream, std::vector<
+    message<isRequest, Body, Headers>, Allocator> const& msgs,
+        WriteHandler&& handler)
+{
+    static_assert(is_AsyncWriteStream<AsyncWriteStream>::value,
+        "AsyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    beast::async_completion<WriteHandler,
+        void(error_code)> completion(handler);
+    detail::write_pipelined_op<AsyncWriteStream,
+        decltype(completion.handler)>{
+            completion.handler, stream, msgs};
+    return completion.result.get();
+}
+
+} // http
+} // beast
+
+#endif
@@ -14,111 +14,210 @@
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/buffer_concepts.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
+#include <beast/core/static_buffer_sequence.hpp>
 #include <beast/core/stream_concepts.hpp>
-#include <beast/core/streambuf.hpp>
-#include <beast/core/write_dynabuf.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/logic/tribool.hpp>
+#include <array>
 #include <condition_variable>
 #include <mutex>
 #include <ostream>
 #include <sstream>
 #include <type_traits>
+#include <vector>
 
 namespace beast {
 namespace http {
 
 namespace detail {
 
-template<class DynamicBuffer, class Body, class Headers>
-void
-write_firstline(DynamicBuffer& dynabuf,
-    message<true, Body, Headers> const& msg)
+// Inline storage for serializing the headers
+// of typical messages without allocating.
+class header_storage
 {
-    write(dynabuf, msg.method);
-    write(dynabuf, " ");
-    write(dynabuf, msg.url);
-    switch(msg.version)
-    {
-    case 10:
-        write(dynabuf, " HTTP/1.0\r\n");
-        break;
-    case 11:
-        write(dynabuf, " HTTP/1.1\r\n");
-        break;
-    default:
-    {
-        std::string s;
-        s = " HTTP/" +
-            std::to_string(msg.version/10) + '.' +
-            std::to_string(msg.version%10) + "\r\n";
-        write(dynabuf, s);
-        break;
+    char buf_[512];
+    header_serializer hs_;
+
+public:
+    header_storage()
+        : hs_(buf_, sizeof(buf_))
+    {
     }
+
+    // The serializer refers to buf_
+    header_storage(header_storage const&) = delete;
+    header_storage& operator=(header_storage const&) = delete;
+
+    header_serializer&
+    get()
+    {
+        return hs_;
     }
-}
+};
 
-template<class DynamicBuffer, class Body, class Headers>
-void
-write_firstline(DynamicBuffer& dynabuf,
-    message<false, Body, Headers> const& msg)
+// Refers to a caller provided header serializer.
+template<class Allocator>
+class header_storage_ref
 {
-    switch(msg.version)
-    {
-    case 10:
-        write(dynabuf, "HTTP/1.0 ");
-        break;
-    case 11:
-        write(dynabuf, "HTTP/1.1 ");
-        break;
-    default:
-    {
-        std::string s;
-        s = " HTTP/" +
-            std::to_string(msg.version/10) + '.' +
-            std::to_string(msg.version%10) + ' ';
-        write(dynabuf, s);
-        break;
+    basic_header_serializer<Allocator>& hs_;
+
+public:
+    explicit
+    header_storage_ref(basic_header_serializer<Allocator>& hs)
+        : hs_(hs)
+    {
     }
+
+    basic_header_serializer<Allocator>&
+    get()
+    {
+        return hs_;
     }
-    write(dynabuf, msg.status);
-    write(dynabuf, " ");
-    write(dynabuf, msg.reason);
-    write(dynabuf, "\r\n");
-}
+};
 
-template<class DynamicBuffer, class FieldSequence>
-void
-write_fields(DynamicBuffer& dynabuf, FieldSequence const& fields)
+// Collects the buffers a writer provides during one call to
+// its write function, so they can be sent in a single gathered
+// write along with the headers and any chunk framing.
+class write_gather
+{
+public:
+    // Buffers held without allocating
+    static std::size_t constexpr inline_size = 8;
+
+private:
+    std::array<boost::asio::const_buffer, inline_size> a_;
+    std::vector<boost::asio::const_buffer> v_;
+    std::size_t n_ = 0;
+    std::size_t size_ = 0;
+
+public:
+    class const_buffers_type
+    {
+        boost::asio::const_buffer const* p_;
+        std::size_t n_;
+
+    public:
+        using value_type = boost::asio::const_buffer;
+        using const_iterator = value_type const*;
+
+        const_buffers_type(value_type const* p, std::size_t n)
+            : p_(p)
+            , n_(n)
+        {
+        }
+
+        const_iterator
+        begin() const
+        {
+            return p_;
+        }
+
+        const_iterator
+        end() const
+        {
+            return p_ + n_;
+        }
+    };
+
+    write_gather() = default;
+    write_gather(write_gather const&) = delete;
+    write_gather& operator=(write_gather const&) = delete;
+
+    // Returns the number of bytes collected
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    // Returns the number of buffers collected
+    std::size_t
+    count() const
+    {
+        return n_;
+    }
+
+    const_buffers_type
+    data() const
+    {
+        return {n_ <= a_.size() ?
+            a_.data() : v_.data(), n_};
+    }
+
+    void
+    clear()
+    {
+        v_.clear();
+        n_ = 0;
+        size_ = 0;
+    }
+
+    template<class ConstBufferSequence>
+    void
+    append(ConstBufferSequence const& buffers)
+    {
+        using boost::asio::buffer_size;
+        for(boost::asio::const_buffer b : buffers)
+        {
+            auto const len = buffer_size(b);
+            if(len == 0)
+                continue;
+            if(n_ < a_.size())
+            {
+                a_[n_] = b;
+            }
+            else
+            {
+                if(n_ == a_.size())
+                    v_.assign(a_.begin(), a_.end());
+                v_.push_back(b);
+            }
+            ++n_;
+            size_ += len;
+        }
+    }
+};
+
+// The write function given to writers
+class gather_function
 {
-    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
-        "DynamicBuffer requirements not met");
-    //static_assert(is_FieldSequence<FieldSequence>::value,
-    //    "FieldSequence requirements not met");
-    for(auto const& field : fields)
-    {
-        write(dynabuf, field.name());
-        write(dynabuf, ": ");
-        write(dynabuf, field.value());
-        write(dynabuf, "\r\n");
+    write_gather& g_;
+
+public:
+    explicit
+    gather_function(write_gather& g)
+        : g_(g)
+    {
     }
-}
 
-template<bool isRequest, class Body, class Headers>
+    template<class ConstBufferSequence>
+    void operator()(ConstBufferSequence const& buffers) const
+    {
+        g_.append(buffers);
+    }
+};
+
+template<bool isRequest, class Body, class Headers,
+    class Serializer>
 struct write_preparation
 {
     message<isRequest, Body, Headers> const& msg;
     typename Body::writer w;
-    streambuf sb;
+    Serializer& hs;
+    write_gather gb;
+    chunk_encode_text chunk;
+    // headers, chunk size, body, and chunk delimiter
+    static_buffer_sequence<write_gather::inline_size + 3> sb;
     bool chunked;
     bool close;
 
-    explicit
     write_preparation(
-            message<isRequest, Body, Headers> const& msg_)
+            message<isRequest, Body, Headers> const& msg_,
+                Serializer& hs_)
         : msg(msg_)
         , w(msg)
+        , hs(hs_)
         , chunked(token_list{
             msg.headers["Transfer-Encoding"]}.exists("chunked"))
         , close(token_list{
@@ -134,98 +233,94 @@ struct write_preparation
         w.init(ec);
         if(ec)
             return;
-        write_firstline(sb, msg);
-        write_fields(sb, msg.headers);
-        beast::write(sb, "\r\n");
+        hs.serialize(msg);
+    }
+
+    // Collect any unsent headers, the gathered body buffers,
+    // and chunk framing into sb. Returns false if they do
+    // not fit, in which case sb is not used.
+    bool
+    flatten(bool last)
+    {
+        if(gb.count() + 3 > sb.capacity())
+            return false;
+        sb.clear();
+        sb.append(hs.data());
+        if(chunked)
+        {
+            auto const n = gb.size();
+            if(n > 0)
+            {
+                chunk = chunk_encode_text{n};
+                sb.append(chunk);
+            }
+            sb.append(gb.data());
+            sb.append(chunk_encode_delim(n > 0, last));
+        }
+        else
+        {
+            sb.append(gb.data());
+        }
+        return true;
     }
 };
 
+// Calls a writer which never suspends
+template<class Writer, class WriteFunction>
+inline
+boost::tribool
+call_write(Writer& w, resume_context&, error_code& ec,
+    WriteFunction&& wf, std::true_type)
+{
+    return w.write(ec, std::forward<WriteFunction>(wf));
+}
+
+// Calls a writer which may suspend
+template<class Writer, class WriteFunction>
+inline
+boost::tribool
+call_write(Writer& w, resume_context& rc, error_code& ec,
+    WriteFunction&& wf, std::false_type)
+{
+    return w.write(std::move(rc), ec,
+        std::forward<WriteFunction>(wf));
+}
+
 template<class Stream, class Handler,
-    bool isRequest, class Body, class Headers>
+    bool isRequest, class Body, class Headers,
+        class Storage = header_storage>
 class write_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
+    using serializer_type = typename std::remove_reference<
+        decltype(std::declval<Storage&>().get())>::type;
+
+    using is_sync = has_sync_write<typename Body::writer>;
 
     struct data
     {
         Stream& s;
-        // VFALCO How do we use handler_alloc in write_preparation?
-        write_preparation<
-            isRequest, Body, Headers> wp;
-        Handler h;
+        Storage storage;
+        write_preparation<isRequest,
+            Body, Headers, serializer_type> wp;
         resume_context resume;
         resume_context copy;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_, Stream& s_,
-                message<isRequest, Body, Headers> const& m_)
+        template<class... Args>
+        data(Handler& h, Stream& s_,
+                message<isRequest, Body, Headers> const& m_,
+                    Args&&... args)
             : s(s_)
-            , wp(m_)
-            , h(std::forward<DeducedHandler>(h_))
+            , storage(std::forward<Args>(args)...)
+            , wp(m_, storage.get())
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
         }
     };
 
-    class writef0_lambda
-    {
-        write_op& self_;
-
-    public:
-        explicit
-        writef0_lambda(write_op& self)
-            : self_(self)
-        {
-        }
-
-        template<class ConstBufferSequence>
-        void operator()(ConstBufferSequence const& buffers) const
-        {
-            auto& d = *self_.d_;
-            // write headers and body
-            if(d.wp.chunked)
-                boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
-                        detail::chunk_encode(buffers)),
-                            std::move(self_));
-            else
-                boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
-                        buffers), std::move(self_));
-        }
-    };
-
-    class writef_lambda
-    {
-        write_op& self_;
-
-    public:
-        explicit
-        writef_lambda(write_op& self)
-            : self_(self)
-        {
-        }
-
-        template<class ConstBufferSequence>
-        void operator()(ConstBufferSequence const& buffers) const
-        {
-            auto& d = *self_.d_;
-            // write body
-            if(d.wp.chunked)
-                boost::asio::async_write(d.s,
-                    detail::chunk_encode(buffers),
-                        std::move(self_));
-            else
-                boost::asio::async_write(d.s,
-                    buffers, std::move(self_));
-        }
-    };
-
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     write_op(write_op&&) = default;
@@ -233,9 +328,31 @@ public:
 
     template<class DeducedHandler, class... Args>
     write_op(DeducedHandler&& h, Stream& s, Args&&... args)
-        : d_(std::allocate_shared<data>(alloc_type{h},
-            std::forward<DeducedHandler>(h), s,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            s, std::forward<Args>(args)...)
+    {
+        init_resume(is_sync{});
+        (*this)(error_code{}, 0, false);
+    }
+
+    explicit
+    write_op(handler_ptr<data, Handler> d)
+        : d_(std::move(d))
+    {
+    }
+
+    void
+    operator()(error_code ec,
+        std::size_t bytes_transferred, bool again = true);
+
+private:
+    void
+    init_resume(std::true_type)
+    {
+    }
+
+    void
+    init_resume(std::false_type)
     {
         auto& d = *d_;
         auto sp = d_;
@@ -249,25 +366,32 @@ public:
                     error_code{}, 0, false));
             }};
         d.copy = d.resume;
-        (*this)(error_code{}, 0, false);
     }
 
-    explicit
-    write_op(std::shared_ptr<data> d)
-        : d_(std::move(d))
+    // Send any unsent headers and the gathered body buffers
+    void
+    send(bool last)
     {
+        auto& d = *d_;
+        if(d.wp.flatten(last))
+            boost::asio::async_write(d.s,
+                d.wp.sb, std::move(*this));
+        else if(d.wp.chunked)
+            boost::asio::async_write(d.s, buffer_cat(
+                d.wp.hs.data(), detail::chunk_encode(
+                    last, d.wp.gb.data())), std::move(*this));
+        else
+            boost::asio::async_write(d.s, buffer_cat(
+                d.wp.hs.data(), d.wp.gb.data()), std::move(*this));
     }
 
-    void
-    operator()(error_code ec,
-        std::size_t bytes_transferred, bool again = true);
-
+public:
     friend
     void* asio_handler_allocate(
         std::size_t size, write_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -275,7 +399,7 @@ public:
         void* p, std::size_t size, write_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -289,14 +413,14 @@ public:
     void asio_handler_invoke(Function&& f, write_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
 template<class Stream, class Handler,
-    bool isRequest, class Body, class Headers>
+    bool isRequest, class Body, class Headers, class Storage>
 void
-write_op<Stream, Handler, isRequest, Body, Headers>::
+write_op<Stream, Handler, isRequest, Body, Headers, Storage>::
 operator()(error_code ec, std::size_t, bool again)
 {
     auto& d = *d_;
@@ -322,14 +446,15 @@ operator()(error_code ec, std::size_t, bool again)
 
         case 1:
         {
-            boost::tribool const result = d.wp.w.write(
-                std::move(d.copy), ec, writef0_lambda{*this});
+            d.wp.gb.clear();
+            boost::tribool const result = call_write(d.wp.w,
+                d.copy, ec, gather_function{d.wp.gb}, is_sync{});
             if(ec)
             {
                 // call handler
                 d.state = 99;
                 d.s.get_io_service().post(bind_handler(
-                    std::move(*this), ec, false));
+                    std::move(*this), ec, 0, false));
                 return;
             }
             if(boost::indeterminate(result))
@@ -338,54 +463,20 @@ operator()(error_code ec, std::size_t, bool again)
                 d.copy = d.resume;
                 return;
             }
-            if(result)
-                d.state = d.wp.chunked ? 4 : 5;
-            else
-                d.state = 2;
+            // write headers, body, and final chunk
+            d.state = result ? 3 : 2;
+            send(bool(result));
             return;
         }
 
         // sent headers and body
         case 2:
-            d.wp.sb.consume(d.wp.sb.size());
-            d.state = 3;
+            d.wp.hs.clear();
+            d.state = 1;
             break;
 
+        // sent everything
         case 3:
-        {
-            boost::tribool result = d.wp.w.write(
-                std::move(d.copy), ec, writef_lambda{*this});
-            if(ec)
-            {
-                // call handler
-                d.state = 99;
-                break;
-            }
-            if(boost::indeterminate(result))
-            {
-                // suspend
-                d.copy = d.resume;
-                return;
-            }
-            if(result)
-                d.state = d.wp.chunked ? 4 : 5;
-            else
-                d.state = 2;
-            return;
-        }
-
-        case 4:
-            // VFALCO Unfortunately the current interface to the
-            //        Writer concept prevents us from coalescing the
-            //        final body chunk with the final chunk delimiter.
-            //
-            // write final chunk
-            d.state = 5;
-            boost::asio::async_write(d.s,
-                detail::chunk_encode_final(), std::move(*this));
-            return;
-
-        case 5:
             if(d.wp.close)
             {
                 // VFALCO TODO Decide on an error code
@@ -395,69 +486,93 @@ operator()(error_code ec, std::size_t, bool again)
             break;
         }
     }
-    d.h(ec);
+    // Break the cycle through the resume context first
     d.resume = {};
     d.copy = {};
+    d_.invoke(ec);
 }
 
-template<class SyncWriteStream, class DynamicBuffer>
-class writef0_lambda
+// Send any unsent headers and the gathered body buffers
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Serializer>
+void
+write_gathered(SyncWriteStream& stream,
+    write_preparation<isRequest, Body, Headers, Serializer>& wp,
+        bool last, error_code& ec)
 {
-    DynamicBuffer const& sb_;
-    SyncWriteStream& stream_;
-    bool chunked_;
-    error_code& ec_;
-
-public:
-    writef0_lambda(SyncWriteStream& stream,
-            DynamicBuffer const& sb, bool chunked, error_code& ec)
-        : sb_(sb)
-        , stream_(stream)
-        , chunked_(chunked)
-        , ec_(ec)
-    {
-    }
-
-    template<class ConstBufferSequence>
-    void operator()(ConstBufferSequence const& buffers) const
-    {
-        // write headers and body
-        if(chunked_)
-            boost::asio::write(stream_, buffer_cat(
-                sb_.data(), detail::chunk_encode(buffers)), ec_);
-        else
-            boost::asio::write(stream_, buffer_cat(
-                sb_.data(), buffers), ec_);
-    }
-};
+    if(wp.flatten(last))
+        boost::asio::write(stream, wp.sb, ec);
+    else if(wp.chunked)
+        boost::asio::write(stream, buffer_cat(wp.hs.data(),
+            detail::chunk_encode(last, wp.gb.data())), ec);
+    else
+        boost::asio::write(stream, buffer_cat(
+            wp.hs.data(), wp.gb.data()), ec);
+    wp.hs.clear();
+}
 
-template<class SyncWriteStream>
-class writef_lambda
+// Writes the headers and body using a writer which
+// never suspends, without a resume context.
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Serializer>
+void
+write_body(SyncWriteStream& stream,
+    write_preparation<isRequest, Body, Headers, Serializer>& wp,
+        error_code& ec, std::true_type)
 {
-    SyncWriteStream& stream_;
-    bool chunked_;
-    error_code& ec_;
-
-public:
-    writef_lambda(SyncWriteStream& stream,
-            bool chunked, error_code& ec)
-        : stream_(stream)
-        , chunked_(chunked)
-        , ec_(ec)
+    for(;;)
     {
+        wp.gb.clear();
+        bool const done =
+            wp.w.write(ec, gather_function{wp.gb});
+        if(ec)
+            return;
+        write_gathered(stream, wp, done, ec);
+        if(ec || done)
+            return;
     }
+}
 
-    template<class ConstBufferSequence>
-    void operator()(ConstBufferSequence const& buffers) const
+// Writes the headers and body using a writer which may
+// suspend, waiting on the calling thread until resumed.
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Serializer>
+void
+write_body(SyncWriteStream& stream,
+    write_preparation<isRequest, Body, Headers, Serializer>& wp,
+        error_code& ec, std::false_type)
+{
+    std::mutex m;
+    std::condition_variable cv;
+    bool ready = false;
+    resume_context resume{
+        [&]
+        {
+            std::lock_guard<std::mutex> lock(m);
+            ready = true;
+            cv.notify_one();
+        }};
+    auto copy = resume;
+    for(;;)
     {
-        // write body
-        if(chunked_)
-            boost::asio::write(stream_,
-                detail::chunk_encode(buffers), ec_);
-        else
-            boost::asio::write(stream_, buffers, ec_);
+        wp.gb.clear();
+        boost::tribool const result = wp.w.write(
+            std::move(copy), ec, gather_function{wp.gb});
+        if(ec)
+            return;
+        if(boost::indeterminate(result))
+        {
+            copy = resume;
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [&]{ return ready; });
+            ready = false;
+            continue;
+        }
+        write_gathered(stream, wp, bool(result), ec);
+        if(ec || result)
+            return;
     }
-};
+}
 
 } // detail
 
@@ -500,72 +615,58 @@ write(SyncWriteStream& stream,
     static_assert(is_Writer<typename Body::writer,
         message<isRequest, Body, Headers>>::value,
             "Writer requirements not met");
-    detail::write_preparation<isRequest, Body, Headers> wp(msg);
+    detail::header_storage storage;
+    beast::http::write(stream, msg, storage.get(), ec);
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_serializer<Allocator>& hs)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    error_code ec;
+    beast::http::write(stream, msg, hs, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_serializer<Allocator>& hs,
+            error_code& ec)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    detail::write_preparation<isRequest, Body, Headers,
+        basic_header_serializer<Allocator>> wp(msg, hs);
     wp.init(ec);
     if(ec)
         return;
-    std::mutex m;
-    std::condition_variable cv;
-    bool ready = false;
-    resume_context resume{
-        [&]
-        {
-            std::lock_guard<std::mutex> lock(m);
-            ready = true;
-            cv.notify_one();
-        }};
-    auto copy = resume;
-    boost::tribool result =
-        wp.w.write(std::move(copy), ec,
-            detail::writef0_lambda<SyncWriteStream,
-                decltype(wp.sb)>{stream,
-                    wp.sb, wp.chunked, ec});
+    detail::write_body(stream, wp, ec, detail::has_sync_write<
+        typename Body::writer>{});
     if(ec)
         return;
-    if(boost::indeterminate(result))
-    {
-        copy = resume;
-        {
-            std::unique_lock<std::mutex> lock(m);
-            cv.wait(lock, [&]{ return ready; });
-            ready = false;
-        }
-        boost::asio::write(stream, wp.sb.data(), ec);
-        if(ec)
-            return;
-        result = false;
-    }
-    wp.sb.consume(wp.sb.size());
-    if(! result)
-    {
-        detail::writef_lambda<SyncWriteStream> wf{
-            stream, wp.chunked, ec};
-        for(;;)
-        {
-            result = wp.w.write(std::move(copy), ec, wf);
-            if(ec)
-                return;
-            if(result)
-                break;
-            if(! result)
-                continue;
-            copy = resume;
-            std::unique_lock<std::mutex> lock(m);
-            cv.wait(lock, [&]{ return ready; });
-            ready = false;
-        }
-    }
-    if(wp.chunked)
-    {
-        // VFALCO Unfortunately the current interface to the
-        //        Writer concept prevents us from using coalescing the
-        //        final body chunk with the final chunk delimiter.
-        //
-        // write final chunk
-        boost::asio::write(stream, detail::chunk_encode_final(), ec);
-        if(ec)
-            return;
-    }
     if(wp.close)
     {
         // VFALCO TODO Decide on an error code
@@ -598,6 +699,34 @@ async_write(AsyncWriteStream& stream,
     return completion.result.get();
 }
 
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class WriteHandler>
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+async_write(AsyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_serializer<Allocator>& hs,
+            WriteHandler&& handler)
+{
+    static_assert(is_AsyncWriteStream<AsyncWriteStream>::value,
+        "AsyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    beast::async_completion<WriteHandler,
+        void(error_code)> completion(handler);
+    detail::write_op<AsyncWriteStream, decltype(completion.handler),
+        isRequest, Body, Headers,
+            detail::header_storage_ref<Allocator>>{
+                completion.handler, stream, msg, hs};
+    return completion.result.get();
+}
+
 namespace detail {
 
 class ostream_SyncStream
@@ -9,6 +9,7 @@
 #define BEAST_HTTP_MESSAGE_HPP
 
 #include <beast/http/basic_headers.hpp>
+#include <beast/http/verb.hpp>
 #include <beast/core/detail/integer_sequence.hpp>
 #include <memory>
 #include <string>
@@ -48,7 +49,20 @@ struct request_headers
     */
     int version;
 
-    /// The HTTP method.
+    /** The HTTP method.
+
+        When this is not `verb::unknown`, the method is written
+        from a static table and @ref method is not used. Parsed
+        requests set this for every method recognized by
+        @ref string_to_verb.
+    */
+    http::verb verb = http::verb::unknown;
+
+    /** The HTTP method, as a string.
+
+        This holds the method when @ref verb equals
+        `verb::unknown`, for example extension methods.
+    */
     std::string method;
 
     /// The request URI.
@@ -93,6 +107,7 @@ swap(
 {
     using std::swap;
     swap(a.version, b.version);
+    swap(a.verb, b.verb);
     swap(a.method, b.method);
     swap(a.url, b.url);
     swap(a.headers, b.headers);
@@ -38,6 +38,9 @@ enum class parse_error
     body_too_big,
     short_read,
 
+    illegal_obs_fold,
+    illegal_transfer_encoding,
+
     general
 };
 
@@ -11,10 +11,13 @@
 #include <beast/http/concepts.hpp>
 #include <beast/http/headers_parser_v1.hpp>
 #include <beast/http/message.hpp>
+#include <beast/http/verb.hpp>
 #include <beast/core/error.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/assert.hpp>
 #include <boost/optional.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <algorithm>
 #include <functional>
 #include <string>
 #include <type_traits>
@@ -54,6 +57,67 @@ struct skip_body
     }
 };
 
+/** Header field filter option.
+
+    Sets a function which decides which header fields are stored
+    in the parsed message. The function is called once for each
+    field, with the complete field name as it appeared in the
+    message, and returns `true` to store the field. The value of
+    a field which is not stored is still validated by the parser,
+    including the fields which determine the framing of the message
+    such as Content-Length, but it is not copied or inserted into
+    the message headers.
+
+    Field names are case-insensitive, so the function should
+    compare them without regard to case.
+
+    Example:
+    @code
+        parser_v1<true, string_body, headers> p;
+        p.set_option(header_filter{
+            [](boost::string_ref const& name)
+            {
+                return beast::detail::ci_equal(name, "Host") ||
+                    beast::detail::ci_equal(name, "Cookie");
+            }});
+    @endcode
+
+    @note Objects of this type are passed to @ref parser_v1::set_option.
+*/
+struct header_filter
+{
+    std::function<bool(boost::string_ref const&)> value;
+
+    explicit
+    header_filter(std::function<
+            bool(boost::string_ref const&)> v)
+        : value(std::move(v))
+    {
+    }
+};
+
+/** Capture filtered fields option.
+
+    When set, the header fields rejected by the @ref header_filter
+    are appended to a single string in the HTTP/1 wire format,
+    one "name: value\r\n" line per field, instead of being
+    discarded. The string is returned by
+    @ref parser_v1::filtered_fields, so that the fields may be
+    parsed later if they are needed.
+
+    @note Objects of this type are passed to @ref parser_v1::set_option.
+*/
+struct capture_filtered
+{
+    bool value;
+
+    explicit
+    capture_filtered(bool v)
+        : value(v)
+    {
+    }
+};
+
 /** A parser for producing HTTP/1 messages.
 
     This class uses the basic HTTP/1 wire format parser to convert
@@ -87,10 +151,14 @@ private:
 
     std::string field_;
     std::string value_;
+    std::string filtered_;
+    std::function<bool(boost::string_ref const&)> filter_;
     message_type m_;
     boost::optional<reader> r_;
     std::uint8_t skip_body_ = 0;
     bool flush_ = false;
+    bool keep_ = true;
+    bool capture_ = false;
 
 public:
     /// Default constructor
@@ -144,6 +212,9 @@ public:
                 isRequest, Body, Headers>>&>(*this) = parser;
     }
 
+    using basic_parser_v1<isRequest,
+        parser_v1<isRequest, Body, Headers>>::set_option;
+
     /// Set the skip body option.
     void
     set_option(skip_body const& o)
@@ -151,6 +222,87 @@ public:
         skip_body_ = o.value ? 1 : 0;
     }
 
+    /// Set the header filter option.
+    void
+    set_option(header_filter const& o)
+    {
+        filter_ = o.value;
+    }
+
+    /// Set the capture filtered fields option.
+    void
+    set_option(capture_filtered const& o)
+    {
+        capture_ = o.value;
+    }
+
+    /** Returns the header fields rejected by the filter.
+
+        The fields are in the HTTP/1 wire format. The string is
+        empty unless the @ref capture_filtered option is set.
+    */
+    std::string const&
+    filtered_fields() const
+    {
+        return filtered_;
+    }
+
+    /** Returns storage for receiving body octets directly.
+
+        When the reader for the body exposes its storage, the
+        octets of a body whose length is given by Content-Length
+        may be read from the stream straight into the body, instead
+        of being copied through a stream buffer. This function
+        returns a mutable buffer sequence of exactly `n` bytes
+        in the body storage. The octets placed in it are not
+        parsed until a subsequent call to @ref commit_body.
+
+        This function only participates in overload resolution
+        if the reader provides `reserve`, `prepare`, and `commit`.
+
+        @param n The number of octets to prepare. This must not
+        be greater than the value returned by `body_remaining`.
+    */
+    template<class R = reader>
+#if GENERATING_DOCS
+    implementation_defined
+#else
+    decltype(std::declval<R&>().prepare(std::size_t{}))
+#endif
+    prepare_body(std::size_t n)
+    {
+        BOOST_ASSERT(r_);
+        BOOST_ASSERT(n <= this->body_remaining());
+        return r_->prepare(n);
+    }
+
+    /** Commit body octets received into prepared storage.
+
+        This function appends `n` octets from the storage returned
+        by the last call to @ref prepare_body to the body, and
+        advances the parser past them. When the last octet of
+        the body is committed, the parse is complete. Unused
+        prepared storage is released; `n` may be zero.
+
+        @param n The number of octets to commit.
+
+        @param ec Set to the error, if any occurred.
+    */
+    template<class R = reader>
+#if GENERATING_DOCS
+    void
+#else
+    typename std::enable_if<
+        detail::is_DirectReader<R>::value>::type
+#endif
+    commit_body(std::size_t n, error_code& ec)
+    {
+        BOOST_ASSERT(r_);
+        r_->commit(n);
+        if(n > 0)
+            this->consume_body(n, ec);
+    }
+
     /** Returns the parsed message.
 
         Only valid if @ref complete would return `true`.
@@ -196,9 +348,16 @@ private:
             return;
         flush_ = false;
         BOOST_ASSERT(! field_.empty());
-        m_.headers.insert(field_, value_);
+        if(keep_)
+        {
+            m_.headers.insert(field_, value_);
+            value_.clear();
+        }
+        else if(capture_)
+        {
+            filtered_.append("\r\n", 2);
+        }
         field_.clear();
-        value_.clear();
     }
 
     void on_start(error_code&)
@@ -222,7 +381,10 @@ private:
 
     void on_request_or_response(std::true_type)
     {
-        m_.method = std::move(this->method_);
+        m_.verb = string_to_verb(this->method_);
+        if(m_.verb == verb::unknown)
+            m_.method = std::move(this->method_);
+        this->method_.clear();
         m_.url = std::move(this->uri_);
     }
 
@@ -252,8 +414,21 @@ private:
 
     void on_value(boost::string_ref const& s, error_code&)
     {
-        value_.append(s.data(), s.size());
-        flush_ = true;
+        if(! flush_)
+        {
+            // The field name is complete, apply the filter once
+            flush_ = true;
+            keep_ = ! filter_ || filter_(field_);
+            if(! keep_ && capture_)
+            {
+                filtered_.append(field_);
+                filtered_.append(": ", 2);
+            }
+        }
+        if(keep_)
+            value_.append(s.data(), s.size());
+        else if(capture_)
+            filtered_.append(s.data(), s.size());
     }
 
     void
@@ -264,21 +439,59 @@ private:
     }
 
     body_what
-    on_body_what(std::uint64_t, error_code& ec)
+    on_body_what(std::uint64_t content_length, error_code& ec)
     {
         if(skip_body_)
             return body_what::skip;
         r_.emplace(m_);
         r_->init(ec);
+        if(! ec && content_length > 0 &&
+                content_length != no_content_length)
+            reserve(content_length, std::integral_constant<bool,
+                detail::is_DirectReader<reader>::value>{});
         return body_what::normal;
     }
 
+    // A Content-Length over the body limit is rejected by the
+    // parser after this returns, so nothing is reserved for it.
+    // Without a limit at most 64KB is reserved up front, so that
+    // a large Content-Length alone cannot cause a large allocation.
+    void
+    reserve(std::uint64_t content_length, std::true_type)
+    {
+        auto const limit = this->body_limit();
+        if(limit == 0)
+            r_->reserve((std::min)(content_length,
+                std::uint64_t{65536}));
+        else if(content_length <= limit)
+            r_->reserve(content_length);
+    }
+
+    void
+    reserve(std::uint64_t, std::false_type)
+    {
+    }
+
     void on_body(boost::string_ref const& s, error_code& ec)
     {
         r_->write(s.data(), s.size(), ec);
     }
 
-    void on_complete(error_code&)
+    void on_complete(error_code& ec)
+    {
+        if(r_)
+            finish(ec, std::integral_constant<bool,
+                detail::has_finish<reader>::value>{});
+    }
+
+    void
+    finish(error_code& ec, std::true_type)
+    {
+        r_->finish(ec);
+    }
+
+    void
+    finish(error_code&, std::false_type)
     {
     }
 };
@@ -0,0 +1,305 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_PIPELINE_HPP
+#define BEAST_HTTP_PIPELINE_HPP
+
+#include <beast/core/async_completion.hpp>
+#include <beast/core/error.hpp>
+#include <beast/http/message.hpp>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+/** Parse every complete HTTP/1 message held in a stream buffer.
+
+    This function parses messages from the input sequence of the
+    stream buffer, appending each complete message to `msgs`, until
+    one of the following conditions is true:
+
+    @li The remaining input does not hold a complete message.
+
+    @li A parsed message indicates that the connection will
+    close, or is an upgrade message.
+
+    @li An error occurs in the parser.
+
+    No I/O is performed. The octets of each complete message are
+    removed from the stream buffer. The octets of an incomplete or
+    invalid message are left in the stream buffer, so that a
+    subsequent read sees them again.
+
+    @param dynabuf A @b `DynamicBuffer` holding the octets to parse.
+
+    @param msgs The container to which parsed messages are appended.
+
+    @param ec Set to the error, if any occurred.
+
+    @return The number of messages appended to `msgs`.
+*/
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+std::size_t
+read_buffered(DynamicBuffer& dynabuf, std::vector<
+    message<isRequest, Body, Headers>, Allocator>& msgs,
+        error_code& ec);
+
+/** Read a batch of pipelined HTTP/1 messages from a stream.
+
+    This function is used to synchronously read one message from
+    the stream, followed by every additional complete message
+    which is already present in the stream buffer. The call blocks
+    until one of the following conditions is true:
+
+    @li At least one complete message is read in.
+
+    @li An error occurs in the stream or parser.
+
+    This function is implemented in terms of one or more calls
+    to the stream's `read_some` function. Only the first message
+    causes reads from the stream, the remaining messages are parsed
+    as if by a call to @ref read_buffered. Errors parsing the
+    buffered messages are not reported, instead the offending
+    octets are left in the stream buffer for the next read.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b `SyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs The container to which messages are appended,
+    in the order they were received.
+
+    @throws system_error Thrown on failure.
+*/
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_pipelined(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs);
+
+/** Read a batch of pipelined HTTP/1 messages from a stream.
+
+    This function is used to synchronously read one message from
+    the stream, followed by every additional complete message
+    which is already present in the stream buffer. The call blocks
+    until one of the following conditions is true:
+
+    @li At least one complete message is read in.
+
+    @li An error occurs in the stream or parser.
+
+    This function is implemented in terms of one or more calls
+    to the stream's `read_some` function. Only the first message
+    causes reads from the stream, the remaining messages are parsed
+    as if by a call to @ref read_buffered. Errors parsing the
+    buffered messages are not reported, instead the offending
+    octets are left in the stream buffer for the next read.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b `SyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs The container to which messages are appended,
+    in the order they were received.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_pipelined(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs,
+        error_code& ec);
+
+/** Start an asynchronous operation to read a batch of pipelined HTTP/1 messages.
+
+    This function is used to asynchronously read one message from
+    the stream, followed by every additional complete message which
+    is already present in the stream buffer. The function call always
+    returns immediately. The asynchronous operation will continue
+    until one of the following conditions is true:
+
+    @li At least one complete message is read in.
+
+    @li An error occurs in the stream or parser.
+
+    This operation is implemented in terms of one or more calls to the
+    next layer's `async_read_some` function, and is known as a
+    <em>composed operation</em>. The program must ensure that the stream
+    performs no other operations until this operation completes.
+
+    @param stream The stream to read the messages from.
+    The type must support the @b `AsyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs The container to which messages are appended, in
+    the order they were received. This object must remain valid
+    until the completion handler is invoked.
+
+    @param handler The handler to be called when the request completes.
+    Copies will be made of the handler as required. The equivalent
+    function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class ReadHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+#endif
+async_read_pipelined(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs,
+        ReadHandler&& handler);
+
+/** Write a batch of HTTP/1 messages to a stream in one gathered write.
+
+    This function serializes each message in order, and sends the
+    result using a single call to `boost::asio::write`. The call
+    will block until one of the following conditions is true:
+
+    @li All of the messages are sent.
+
+    @li An error occurs.
+
+    The bodies of the messages are copied into an internal buffer,
+    so this function is best suited to batches of small messages,
+    such as the responses to pipelined requests. If the semantics
+    of a message indicate that the connection should be closed
+    after it is sent, the messages following it are not sent and
+    the error thrown from this function will be
+    `boost::asio::error::eof`.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param msgs The messages to write.
+
+    @throws system_error Thrown on failure.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write_pipelined(SyncWriteStream& stream, std::vector<
+    message<isRequest, Body, Headers>, Allocator> const& msgs);
+
+/** Write a batch of HTTP/1 messages to a stream in one gathered write.
+
+    This function serializes each message in order, and sends the
+    result using a single call to `boost::asio::write`. The call
+    will block until one of the following conditions is true:
+
+    @li All of the messages are sent.
+
+    @li An error occurs.
+
+    The bodies of the messages are copied into an internal buffer,
+    so this function is best suited to batches of small messages,
+    such as the responses to pipelined requests. If the semantics
+    of a message indicate that the connection should be closed
+    after it is sent, the messages following it are not sent and
+    the error returned from this function will be
+    `boost::asio::error::eof`.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param msgs The messages to write.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write_pipelined(SyncWriteStream& stream, std::vector<
+    message<isRequest, Body, Headers>, Allocator> const& msgs,
+        error_code& ec);
+
+/** Start an asynchronous operation to write a batch of HTTP/1 messages.
+
+    This function serializes each message in order, and sends the
+    result using a single call to `boost::asio::async_write`. The
+    function call always returns immediately. The asynchronous
+    operation will continue until one of the following conditions
+    is true:
+
+    @li All of the messages are sent.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls to the
+    stream's `async_write_some` functions, and is known as a <em>composed
+    operation</em>. The program must ensure that the stream performs no
+    other write operations until this operation completes.
+
+    The bodies of the messages are copied into an internal buffer.
+    If the semantics of a message indicate that the connection should
+    be closed after it is sent, the messages following it are not sent
+    and the operation will complete with the error set to
+    `boost::asio::error::eof`.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `AsyncWriteStream` concept.
+
+    @param msgs The messages to send. The messages are serialized
+    before this function returns, so the container need not remain
+    valid until the completion handler is called.
+
+    @param handler The handler to be called when the request completes.
+    Copies will be made of the handler as required. The equivalent
+    function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class WriteHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+#endif
+async_write_pipelined(AsyncWriteStream& stream, std::vector<
+    message<isRequest, Body, Headers>, Allocator> const& msgs,
+        WriteHandler&& handler);
+
+} // http
+} // beast
+
+#include <beast/http/impl/pipeline.ipp>
+
+#endif
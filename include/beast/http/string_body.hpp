@@ -33,6 +33,7 @@ private:
     class reader
     {
         value_type& s_;
+        std::size_t len_ = 0;
 
     public:
         template<bool isRequest, class Headers>
@@ -56,6 +57,28 @@ private:
             s_.resize(n + size);
             std::memcpy(&s_[n], data, size);
         }
+
+        void
+        reserve(std::uint64_t n)
+        {
+            if(n <= s_.max_size() - s_.size())
+                s_.reserve(s_.size() +
+                    static_cast<std::size_t>(n));
+        }
+
+        boost::asio::mutable_buffers_1
+        prepare(std::size_t n)
+        {
+            len_ = s_.size();
+            s_.resize(len_ + n);
+            return boost::asio::buffer(&s_[len_], n);
+        }
+
+        void
+        commit(std::size_t n) noexcept
+        {
+            s_.resize(len_ + n);
+        }
     };
 
     class writer
@@ -84,9 +107,8 @@ private:
         }
 
         template<class WriteFunction>
-        boost::tribool
-        write(resume_context&&, error_code&,
-            WriteFunction&& wf) noexcept
+        bool
+        write(error_code&, WriteFunction&& wf) noexcept
         {
             wf(boost::asio::buffer(body_));
             return true;
@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_VERB_HPP
+#define BEAST_HTTP_VERB_HPP
+
+#include <boost/utility/string_ref.hpp>
+
+namespace beast {
+namespace http {
+
+/** HTTP request methods.
+
+    This contains the request methods recognized by the parser.
+    Methods not in this list are represented by `verb::unknown`,
+    with the method text stored as a string in the message.
+
+    @note The values are case-sensitive, as required by rfc7230.
+*/
+enum class verb
+{
+    /// The request method is not one of the values below.
+    unknown = 0,
+
+    delete_,
+    get,
+    head,
+    post,
+    put,
+    connect,
+    options,
+    trace,
+
+    // WebDAV
+    copy,
+    lock,
+    mkcol,
+    move,
+    propfind,
+    proppatch,
+    search,
+    unlock,
+    bind,
+    rebind,
+    unbind,
+    acl,
+
+    // subversion
+    report,
+    mkactivity,
+    checkout,
+    merge,
+
+    // upnp
+    msearch,
+    notify,
+    subscribe,
+    unsubscribe,
+
+    // RFC-5789
+    patch,
+    purge,
+
+    // CalDAV
+    mkcalendar,
+
+    // RFC-2068, section 19.6.1.2
+    link,
+    unlink
+};
+
+/** Returns the text for a request method verb.
+
+    An empty string is returned for `verb::unknown`.
+*/
+template<class = void>
+boost::string_ref
+method_string(verb v)
+{
+    static boost::string_ref const table[] = {
+        "",
+        "DELETE",
+        "GET",
+        "HEAD",
+        "POST",
+        "PUT",
+        "CONNECT",
+        "OPTIONS",
+        "TRACE",
+        "COPY",
+        "LOCK",
+        "MKCOL",
+        "MOVE",
+        "PROPFIND",
+        "PROPPATCH",
+        "SEARCH",
+        "UNLOCK",
+        "BIND",
+        "REBIND",
+        "UNBIND",
+        "ACL",
+        "REPORT",
+        "MKACTIVITY",
+        "CHECKOUT",
+        "MERGE",
+        "M-SEARCH",
+        "NOTIFY",
+        "SUBSCRIBE",
+        "UNSUBSCRIBE",
+        "PATCH",
+        "PURGE",
+        "MKCALENDAR",
+        "LINK",
+        "UNLINK"
+    };
+    static_assert(sizeof(table) / sizeof(*table) ==
+        static_cast<std::size_t>(verb::unlink) + 1,
+            "missing method string");
+    auto const i = static_cast<std::size_t>(v);
+    if(i >= sizeof(table) / sizeof(*table))
+        return table[0];
+    return table[i];
+}
+
+/** Converts request method text to a verb.
+
+    The first octet and the length of the string select at
+    most one candidate, which is then compared in full.
+
+    @return The matching verb, or `verb::unknown` if the
+    text is not a recognized method.
+*/
+template<class = void>
+verb
+string_to_verb(boost::string_ref const& s)
+{
+    auto const is =
+        [&](verb v)
+        {
+            return s == method_string(v) ? v : verb::unknown;
+        };
+    if(s.size() < 3 || s.size() > 11)
+        return verb::unknown;
+    switch(s[0])
+    {
+    case 'A':
+        return is(verb::acl);
+
+    case 'B':
+        return is(verb::bind);
+
+    case 'C':
+        switch(s.size())
+        {
+        case 4: return is(verb::copy);
+        case 7: return is(verb::connect);
+        case 8: return is(verb::checkout);
+        }
+        break;
+
+    case 'D':
+        return is(verb::delete_);
+
+    case 'G':
+        return is(verb::get);
+
+    case 'H':
+        return is(verb::head);
+
+    case 'L':
+        if(s[1] == 'I')
+            return is(verb::link);
+        return is(verb::lock);
+
+    case 'M':
+        switch(s.size())
+        {
+        case 4: return is(verb::move);
+        case 5:
+            if(s[1] == 'E')
+                return is(verb::merge);
+            return is(verb::mkcol);
+        case 8: return is(verb::msearch);
+        case 10:
+            if(s[2] == 'A')
+                return is(verb::mkactivity);
+            return is(verb::mkcalendar);
+        }
+        break;
+
+    case 'N':
+        return is(verb::notify);
+
+    case 'O':
+        return is(verb::options);
+
+    case 'P':
+        switch(s.size())
+        {
+        case 3: return is(verb::put);
+        case 4: return is(verb::post);
+        case 5:
+            if(s[1] == 'A')
+                return is(verb::patch);
+            return is(verb::purge);
+        case 8: return is(verb::propfind);
+        case 9: return is(verb::proppatch);
+        }
+        break;
+
+    case 'R':
+        if(s[2] == 'B')
+            return is(verb::rebind);
+        return is(verb::report);
+
+    case 'S':
+        if(s.size() == 6)
+            return is(verb::search);
+        return is(verb::subscribe);
+
+    case 'T':
+        return is(verb::trace);
+
+    case 'U':
+        if(s.size() == 11)
+            return is(verb::unsubscribe);
+        if(s.size() != 6)
+            break;
+        if(s[2] == 'B')
+            return is(verb::unbind);
+        if(s[3] == 'I')
+            return is(verb::unlink);
+        return is(verb::unlock);
+    }
+    return verb::unknown;
+}
+
+} // http
+} // beast
+
+#endif
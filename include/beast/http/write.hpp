@@ -8,6 +8,7 @@
 #ifndef BEAST_HTTP_WRITE_HPP
 #define BEAST_HTTP_WRITE_HPP
 
+#include <beast/http/header_serializer.hpp>
 #include <beast/http/message.hpp>
 #include <beast/core/error.hpp>
 #include <beast/core/async_completion.hpp>
@@ -80,6 +81,71 @@ write(SyncWriteStream& stream,
     message<isRequest, Body, Headers> const& msg,
         error_code& ec);
 
+/** Write a HTTP/1 message on a stream using a header serializer.
+
+    This function is used to write a message to a stream. The call
+    will block until one of the following conditions is true:
+
+    @li The entire message is sent.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls
+    to the stream's `write_some` function.
+
+    The headers are serialized using the provided serializer, whose
+    storage is reused. Keeping one serializer per connection avoids
+    allocating memory for the headers of each message.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param msg The message to write.
+
+    @param hs The header serializer to use.
+
+    @throws system_error Thrown on failure.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_serializer<Allocator>& hs);
+
+/** Write a HTTP/1 message on a stream using a header serializer.
+
+    This function is used to write a message to a stream. The call
+    will block until one of the following conditions is true:
+
+    @li The entire message is sent.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls
+    to the stream's `write_some` function.
+
+    The headers are serialized using the provided serializer, whose
+    storage is reused. Keeping one serializer per connection avoids
+    allocating memory for the headers of each message.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param msg The message to write.
+
+    @param hs The header serializer to use.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_serializer<Allocator>& hs,
+            error_code& ec);
+
 /** Start an asynchronous operation to write a HTTP/1 message to a stream.
 
     This function is used to asynchronously write a message to a stream.
@@ -135,6 +201,61 @@ async_write(AsyncWriteStream& stream,
     message<isRequest, Body, Headers> const& msg,
         WriteHandler&& handler);
 
+/** Start an asynchronous operation to write a HTTP/1 message using a header serializer.
+
+    This function is used to asynchronously write a message to a stream.
+    The function call always returns immediately. The asynchronous
+    operation will continue until one of the following conditions is true:
+
+    @li The entire message is sent.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls to the
+    stream's `async_write_some` functions, and is known as a <em>composed
+    operation</em>. The program must ensure that the stream performs no
+    other write operations until this operation completes.
+
+    The headers are serialized using the provided serializer, whose
+    storage is reused. Keeping one serializer per connection avoids
+    allocating memory for the headers of each message.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `AsyncWriteStream` concept.
+
+    @param msg The message to send.
+
+    @param hs The header serializer to use. This object must remain
+    valid until the completion handler is called.
+
+    @param handler The handler to be called when the request completes.
+    Copies will be made of the handler as required. The equivalent
+    function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+
+    @note The message object must remain valid at least until the
+          completion handler is called, no copies are made.
+*/
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class WriteHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+#endif
+async_write(AsyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_serializer<Allocator>& hs,
+            WriteHandler&& handler);
+
 /** Serialize a HTTP/1 message to an ostream.
 
     The function converts the message to its HTTP/1 serialized
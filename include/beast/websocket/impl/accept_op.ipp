@@ -12,7 +12,7 @@
 #include <beast/http/message.hpp>
 #include <beast/http/parser_v1.hpp>
 #include <beast/http/read.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
 #include <beast/core/prepare_buffers.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/assert.hpp>
@@ -28,22 +28,17 @@ template<class NextLayer>
 template<class Handler>
 class stream<NextLayer>::accept_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
-
     struct data
     {
         stream<NextLayer>& ws;
         http::request<http::string_body> req;
-        Handler h;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler, class Buffers>
-        data(DeducedHandler&& h_, stream<NextLayer>& ws_,
+        template<class Buffers>
+        data(Handler& h, stream<NextLayer>& ws_,
                 Buffers const& buffers)
             : ws(ws_)
-            , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
@@ -56,7 +51,7 @@ class stream<NextLayer>::accept_op
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     accept_op(accept_op&&) = default;
@@ -65,9 +60,8 @@ public:
     template<class DeducedHandler, class... Args>
     accept_op(DeducedHandler&& h,
             stream<NextLayer>& ws, Args&&... args)
-        : d_(std::allocate_shared<data>(alloc_type{h},
-            std::forward<DeducedHandler>(h), ws,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            ws, std::forward<Args>(args)...)
     {
         (*this)(error_code{}, 0, false);
     }
@@ -85,7 +79,7 @@ public:
         std::size_t size, accept_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -93,7 +87,7 @@ public:
         void* p, std::size_t size, accept_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -107,7 +101,7 @@ public:
     void asio_handler_invoke(Function&& f, accept_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -142,12 +136,12 @@ operator()(error_code const& ec,
             d.ws.async_accept(d.req, *this);
 #else
             response_op<Handler>{
-                std::move(d.h), d.ws, d.req, true};
+                d_.handler(), d.ws, d.req, true};
 #endif
             return;
         }
     }
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // websocket
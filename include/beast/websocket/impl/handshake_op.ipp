@@ -12,7 +12,7 @@
 #include <beast/http/message.hpp>
 #include <beast/http/read.hpp>
 #include <beast/http/write.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
 #include <boost/assert.hpp>
 #include <memory>
 
@@ -25,25 +25,19 @@ template<class NextLayer>
 template<class Handler>
 class stream<NextLayer>::handshake_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
-
     struct data
     {
         stream<NextLayer>& ws;
-        Handler h;
         std::string key;
         http::request<http::empty_body> req;
         http::response<http::string_body> resp;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_, stream<NextLayer>& ws_,
+        data(Handler& h, stream<NextLayer>& ws_,
             boost::string_ref const& host,
                 boost::string_ref const& resource)
             : ws(ws_)
-            , h(std::forward<DeducedHandler>(h_))
             , req(ws.build_request(host, resource, key))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
@@ -52,7 +46,7 @@ class stream<NextLayer>::handshake_op
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     handshake_op(handshake_op&&) = default;
@@ -61,9 +55,8 @@ public:
     template<class DeducedHandler, class... Args>
     handshake_op(DeducedHandler&& h,
             stream<NextLayer>& ws, Args&&... args)
-        : d_(std::allocate_shared<data>(alloc_type{h},
-            std::forward<DeducedHandler>(h), ws,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            ws, std::forward<Args>(args)...)
     {
         (*this)(error_code{}, false);
     }
@@ -76,7 +69,7 @@ public:
         std::size_t size, handshake_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -84,7 +77,7 @@ public:
         void* p, std::size_t size, handshake_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -98,7 +91,7 @@ public:
     void asio_handler_invoke(Function&& f, handshake_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -144,7 +137,7 @@ operator()(error_code ec, bool again)
         }
         }
     }
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // websocket
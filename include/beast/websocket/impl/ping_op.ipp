@@ -9,7 +9,7 @@
 #define BEAST_WEBSOCKET_IMPL_PING_OP_HPP
 
 #include <beast/core/bind_handler.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
 #include <beast/websocket/detail/frame.hpp>
 #include <memory>
 
@@ -22,22 +22,16 @@ template<class NextLayer>
 template<class Handler>
 class stream<NextLayer>::ping_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
-
     struct data : op
     {
         stream<NextLayer>& ws;
-        Handler h;
         detail::frame_streambuf fb;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_, stream<NextLayer>& ws_,
+        data(Handler& h, stream<NextLayer>& ws_,
                 ping_data const& payload)
             : ws(ws_)
-            , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
@@ -48,7 +42,7 @@ class stream<NextLayer>::ping_op
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     ping_op(ping_op&&) = default;
@@ -57,9 +51,8 @@ public:
     template<class DeducedHandler, class... Args>
     ping_op(DeducedHandler&& h,
             stream<NextLayer>& ws, Args&&... args)
-        : d_(std::make_shared<data>(
-            std::forward<DeducedHandler>(h), ws,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            ws, std::forward<Args>(args)...)
     {
         (*this)(error_code{}, false);
     }
@@ -78,7 +71,7 @@ public:
         std::size_t size, ping_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -86,7 +79,7 @@ public:
         void* p, std::size_t size, ping_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -100,7 +93,7 @@ public:
     void asio_handler_invoke(Function&& f, ping_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -184,7 +177,7 @@ upcall:
     if(d.ws.wr_block_ == &d)
         d.ws.wr_block_ = nullptr;
     d.ws.rd_op_.maybe_invoke();
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // websocket
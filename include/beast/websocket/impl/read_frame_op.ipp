@@ -9,7 +9,7 @@
 #define BEAST_WEBSOCKET_IMPL_READ_FRAME_OP_HPP
 
 #include <beast/websocket/teardown.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
 #include <beast/core/prepare_buffers.hpp>
 #include <beast/core/static_streambuf.hpp>
 #include <boost/assert.hpp>
@@ -26,9 +26,6 @@ template<class NextLayer>
 template<class DynamicBuffer, class Handler>
 class stream<NextLayer>::read_frame_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
-
     using fb_type =
         detail::frame_streambuf;
 
@@ -43,27 +40,24 @@ class stream<NextLayer>::read_frame_op
         stream<NextLayer>& ws;
         frame_info& fi;
         DynamicBuffer& db;
-        Handler h;
         fb_type fb;
         boost::optional<dmb_type> dmb;
         boost::optional<fmb_type> fmb;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_, stream<NextLayer>& ws_,
+        data(Handler& h, stream<NextLayer>& ws_,
                 frame_info& fi_, DynamicBuffer& sb_)
             : ws(ws_)
             , fi(fi_)
             , db(sb_)
-            , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     read_frame_op(read_frame_op&&) = default;
@@ -72,9 +66,8 @@ public:
     template<class DeducedHandler, class... Args>
     read_frame_op(DeducedHandler&& h,
             stream<NextLayer>& ws, Args&&... args)
-        : d_(std::allocate_shared<data>(alloc_type{h},
-            std::forward<DeducedHandler>(h), ws,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            ws, std::forward<Args>(args)...)
     {
         (*this)(error_code{}, 0, false);
     }
@@ -100,7 +93,7 @@ public:
         std::size_t size, read_frame_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -108,7 +101,7 @@ public:
         void* p, std::size_t size, read_frame_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -122,7 +115,7 @@ public:
     void asio_handler_invoke(Function&& f, read_frame_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -538,7 +531,7 @@ upcall:
     if(d.ws.wr_block_ == &d)
         d.ws.wr_block_ = nullptr;
     d.ws.wr_op_.maybe_invoke();
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // websocket
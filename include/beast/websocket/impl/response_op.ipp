@@ -11,7 +11,7 @@
 #include <beast/http/message.hpp>
 #include <beast/http/string_body.hpp>
 #include <beast/http/write.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
 #include <memory>
 
 namespace beast {
@@ -22,26 +22,20 @@ template<class NextLayer>
 template<class Handler>
 class stream<NextLayer>::response_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
-
     struct data
     {
         stream<NextLayer>& ws;
         http::response<http::string_body> resp;
-        Handler h;
         error_code final_ec;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler,
-            class Body, class Headers>
-        data(DeducedHandler&& h_, stream<NextLayer>& ws_,
+        template<class Body, class Headers>
+        data(Handler&, stream<NextLayer>& ws_,
             http::request<Body, Headers> const& req,
                 bool cont_)
             : ws(ws_)
             , resp(ws_.build_response(req))
-            , h(std::forward<DeducedHandler>(h_))
             , cont(cont_)
         {
             // can't call stream::reset() here
@@ -52,7 +46,7 @@ class stream<NextLayer>::response_op
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     response_op(response_op&&) = default;
@@ -61,9 +55,8 @@ public:
     template<class DeducedHandler, class... Args>
     response_op(DeducedHandler&& h,
             stream<NextLayer>& ws, Args&&... args)
-        : d_(std::allocate_shared<data>(alloc_type{h},
-            std::forward<DeducedHandler>(h), ws,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            ws, std::forward<Args>(args)...)
     {
         (*this)(error_code{}, false);
     }
@@ -76,7 +69,7 @@ public:
         std::size_t size, response_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -84,7 +77,7 @@ public:
         void* p, std::size_t size, response_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -98,7 +91,7 @@ public:
     void asio_handler_invoke(Function&& f, response_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -130,7 +123,7 @@ operator()(error_code ec, bool again)
             break;
         }
     }
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // websocket
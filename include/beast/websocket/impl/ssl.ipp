@@ -10,6 +10,7 @@
 
 #include <beast/core/async_completion.hpp>
 #include <beast/core/handler_concepts.hpp>
+#include <beast/core/handler_ptr.hpp>
 
 namespace beast {
 namespace websocket {
@@ -39,30 +40,25 @@ class teardown_ssl_op
     struct data
     {
         stream_type& stream;
-        Handler h;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_,
-                stream_type& stream_)
+        data(Handler& h, stream_type& stream_)
             : stream(stream_)
-            , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     template<class DeducedHandler>
     explicit
     teardown_ssl_op(
             DeducedHandler&& h, stream_type& stream)
-        : d_(std::make_shared<data>(
-            std::forward<DeducedHandler>(h), stream))
+        : d_(std::forward<DeducedHandler>(h), stream)
     {
         (*this)(error_code{}, false);
     }
@@ -75,7 +71,7 @@ public:
         teardown_ssl_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -83,7 +79,7 @@ public:
         std::size_t size, teardown_ssl_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -99,7 +95,7 @@ public:
         teardown_ssl_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -120,7 +116,7 @@ operator()(error_code ec, bool again)
             return;
         }
     }
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // detail
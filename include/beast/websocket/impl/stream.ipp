@@ -27,6 +27,7 @@
 #include <beast/core/buffer_concepts.hpp>
 #include <beast/core/consuming_buffers.hpp>
 #include <beast/core/prepare_buffers.hpp>
+#include <beast/core/static_buffer_sequence.hpp>
 #include <beast/core/static_streambuf.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <boost/assert.hpp>
@@ -730,7 +731,8 @@ write_frame(bool fin,
             detail::write<static_streambuf>(fh_buf, fh);
             // send header and payload
             boost::asio::write(stream_,
-                buffer_cat(fh_buf.data(), mb), ec);
+                static_buffer_sequence<2>{
+                    fh_buf.data(), mb}, ec);
             failed_ = ec != 0;
             if(failed_)
                 return;
@@ -763,7 +765,8 @@ write_frame(bool fin,
             detail::mask_inplace(mb, key);
             // send header and payload
             boost::asio::write(stream_,
-                buffer_cat(fh_buf.data(), mb), ec);
+                static_buffer_sequence<2>{
+                    fh_buf.data(), mb}, ec);
             failed_ = ec != 0;
             if(failed_)
                 return;
@@ -847,7 +850,7 @@ build_request(boost::string_ref const& host,
     http::request<http::empty_body> req;
     req.url = { resource.data(), resource.size() };
     req.version = 11;
-    req.method = "GET";
+    req.verb = http::verb::get;
     req.headers.insert("Host", host);
     req.headers.insert("Upgrade", "websocket");
     key = detail::make_sec_ws_key(maskgen_);
@@ -881,7 +884,8 @@ build_response(http::request<Body, Headers> const& req)
         };
     if(req.version < 11)
         return err("HTTP version 1.1 required");
-    if(req.method != "GET")
+    if(req.verb != http::verb::get && ! (
+            req.verb == http::verb::unknown && req.method == "GET"))
         return err("Wrong method");
     if(! is_upgrade(req))
         return err("Expected Upgrade request");
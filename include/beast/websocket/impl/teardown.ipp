@@ -10,6 +10,7 @@
 
 #include <beast/core/async_completion.hpp>
 #include <beast/core/handler_concepts.hpp>
+#include <beast/core/handler_ptr.hpp>
 #include <memory>
 
 namespace beast {
@@ -26,31 +27,26 @@ class teardown_tcp_op
     struct data
     {
         socket_type& socket;
-        Handler h;
         char buf[8192];
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_, socket_type& socket_)
+        data(Handler& h, socket_type& socket_)
             : socket(socket_)
-            , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     template<class DeducedHandler>
     teardown_tcp_op(
         DeducedHandler&& h,
             socket_type& socket)
-        : d_(std::make_shared<data>(
-            std::forward<DeducedHandler>(h),
-                socket))
+        : d_(std::forward<DeducedHandler>(h), socket)
     {
         (*this)(error_code{}, 0, false);
     }
@@ -63,7 +59,7 @@ public:
         teardown_tcp_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -71,7 +67,7 @@ public:
         std::size_t size, teardown_tcp_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -86,7 +82,7 @@ public:
         teardown_tcp_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -119,7 +115,7 @@ operator()(error_code ec, std::size_t, bool again)
         d.socket.close(ec);
         ec = error_code{};
     }
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // detail
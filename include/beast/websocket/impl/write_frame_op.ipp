@@ -11,7 +11,8 @@
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/consuming_buffers.hpp>
-#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_ptr.hpp>
+#include <beast/core/static_buffer_sequence.hpp>
 #include <beast/core/static_streambuf.hpp>
 #include <beast/websocket/detail/frame.hpp>
 #include <boost/assert.hpp>
@@ -27,14 +28,11 @@ template<class NextLayer>
 template<class Buffers, class Handler>
 class stream<NextLayer>::write_frame_op
 {
-    using alloc_type =
-        handler_alloc<char, Handler>;
-
     struct data : op
     {
+        Handler& h;
         stream<NextLayer>& ws;
         consuming_buffers<Buffers> cb;
-        Handler h;
         detail::frame_header fh;
         detail::fh_streambuf fh_buf;
         detail::prepared_key_type key;
@@ -44,12 +42,11 @@ class stream<NextLayer>::write_frame_op
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_, stream<NextLayer>& ws_,
+        data(Handler& h_, stream<NextLayer>& ws_,
                 bool fin, Buffers const& bs)
-            : ws(ws_)
+            : h(h_)
+            , ws(ws_)
             , cb(bs)
-            , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
@@ -87,7 +84,7 @@ class stream<NextLayer>::write_frame_op
         }
     };
 
-    std::shared_ptr<data> d_;
+    handler_ptr<data, Handler> d_;
 
 public:
     write_frame_op(write_frame_op&&) = default;
@@ -96,9 +93,8 @@ public:
     template<class DeducedHandler, class... Args>
     write_frame_op(DeducedHandler&& h,
             stream<NextLayer>& ws, Args&&... args)
-        : d_(std::make_shared<data>(
-            std::forward<DeducedHandler>(h), ws,
-                std::forward<Args>(args)...))
+        : d_(std::forward<DeducedHandler>(h),
+            ws, std::forward<Args>(args)...)
     {
         (*this)(error_code{}, false);
     }
@@ -117,7 +113,7 @@ public:
         std::size_t size, write_frame_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            allocate(size, op->d_->h);
+            allocate(size, op->d_.handler());
     }
 
     friend
@@ -125,7 +121,7 @@ public:
         void* p, std::size_t size, write_frame_op* op)
     {
         return boost_asio_handler_alloc_helpers::
-            deallocate(p, size, op->d_->h);
+            deallocate(p, size, op->d_.handler());
     }
 
     friend
@@ -139,7 +135,7 @@ public:
     void asio_handler_invoke(Function&& f, write_frame_op* op)
     {
         return boost_asio_handler_invoke_helpers::
-            invoke(f, op->d_->h);
+            invoke(f, op->d_.handler());
     }
 };
 
@@ -218,8 +214,8 @@ operator()(error_code ec, bool again)
             BOOST_ASSERT(! d.ws.wr_block_);
             d.ws.wr_block_ = &d;
             boost::asio::async_write(d.ws.stream_,
-                buffer_cat(d.fh_buf.data(),
-                    mb), std::move(*this));
+                static_buffer_sequence<2>{
+                    d.fh_buf.data(), mb}, std::move(*this));
             return;
         }
 
@@ -273,7 +269,7 @@ upcall:
     if(d.ws.wr_block_ == &d)
         d.ws.wr_block_ = nullptr;
     d.ws.rd_op_.maybe_invoke();
-    d.h(ec);
+    d_.invoke(ec);
 }
 
 } // websocket
@@ -241,10 +241,11 @@ struct pong_callback
 
 /** Read buffer size option.
 
-    Sets the number of bytes allocated to the socket's read buffer.
-    If this is zero, then reads are not buffered. Setting this
+    Sets the maximum number of bytes allocated to the socket's read
+    buffer. If this is zero, then reads are not buffered. Setting this
     higher can improve performance when expecting to receive
-    many small frames.
+    many small frames. The amount read ahead starts small and
+    grows towards this limit while the peer keeps the buffer full.
 
     The default is no buffering.
 
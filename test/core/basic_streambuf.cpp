@@ -25,6 +25,7 @@ struct test_allocator_info
     std::size_t ncopy = 0;
     std::size_t nmove = 0;
     std::size_t nselect = 0;
+    std::size_t nalloc = 0;
 };
 
 template<class T,
@@ -114,6 +115,7 @@ public:
     value_type*
     allocate(std::size_t n)
     {
+        ++info_->nalloc;
         return static_cast<value_type*>(
             ::operator new (n*sizeof(value_type)));
     }
@@ -466,6 +468,65 @@ public:
         }
     }
 
+    void testFreeList()
+    {
+        using alloc_type =
+            test_allocator<char, false, false, false, false>;
+        using sb_type = basic_streambuf<alloc_type>;
+        // Each message fills a buffer, which is then spent
+        auto const cycle =
+            [](sb_type& sb)
+            {
+                for(int i = 0; i < 10; ++i)
+                {
+                    sb.commit(boost::asio::buffer_copy(sb.prepare(1500),
+                        boost::asio::buffer(std::string(1500, '*'))));
+                    sb.consume(1500);
+                }
+            };
+        {
+            sb_type sb;
+            BEAST_EXPECT(sb.max_free() == 0);
+            cycle(sb);
+            auto const n = sb.get_allocator()->nalloc;
+            cycle(sb);
+            BEAST_EXPECT(sb.get_allocator()->nalloc > n);
+        }
+        {
+            sb_type sb;
+            sb.max_free(2);
+            BEAST_EXPECT(sb.max_free() == 2);
+            cycle(sb);
+            auto const n = sb.get_allocator()->nalloc;
+            cycle(sb);
+            BEAST_EXPECT(sb.get_allocator()->nalloc == n);
+            BEAST_EXPECT(sb.size() == 0);
+            sb_type sb2(std::move(sb));
+            BEAST_EXPECT(sb2.max_free() == 2);
+            cycle(sb2);
+            BEAST_EXPECT(sb2.get_allocator()->nalloc == n);
+            sb2.max_free(0);
+            cycle(sb2);
+            BEAST_EXPECT(sb2.get_allocator()->nalloc > n);
+        }
+        {
+            // Reused buffers hold the right data
+            streambuf sb(10);
+            sb.max_free(8);
+            std::string s;
+            for(int i = 0; i < 100; ++i)
+            {
+                std::string const t(i % 37, static_cast<char>('a' + i % 26));
+                sb << t;
+                s += t;
+                auto const n = std::min<std::size_t>(s.size(), i % 23);
+                sb.consume(n);
+                s.erase(0, n);
+                BEAST_EXPECT(to_string(sb.data()) == s);
+            }
+        }
+    }
+
     void run() override
     {
         testSpecialMembers();
@@ -477,6 +538,7 @@ public:
         testIterators();
         testOutputStream();
         testCapacity();
+        testFreeList();
     }
 };
 
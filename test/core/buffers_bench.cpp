@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/buffer_cat.hpp>
+#include <beast/core/consuming_buffers.hpp>
+#include <beast/core/error.hpp>
+#include <beast/core/prepare_buffers.hpp>
+#include <beast/core/static_buffer_sequence.hpp>
+#include <beast/test/timed_test.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/write.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace beast {
+
+class buffers_bench_test : public beast::unit_test::suite
+{
+public:
+    // Bytes in each buffer of a sequence
+    static std::size_t constexpr Size = 16;
+
+    // Operations per trial
+    static std::size_t constexpr N = 1000000;
+
+    // A cheaply copied view of a vector of buffers, so that
+    // copies measure the adapters rather than the sequence.
+    class bidirectional_buffers
+    {
+        using list_type = std::vector<boost::asio::const_buffer>;
+
+        list_type const* v_;
+
+    public:
+        using value_type = boost::asio::const_buffer;
+
+        class const_iterator
+        {
+            list_type::const_iterator it_;
+
+        public:
+            using value_type = boost::asio::const_buffer;
+            using pointer = value_type const*;
+            using reference = value_type const&;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category =
+                std::bidirectional_iterator_tag;
+
+            const_iterator() = default;
+
+            explicit
+            const_iterator(list_type::const_iterator it)
+                : it_(it)
+            {
+            }
+
+            bool
+            operator==(const_iterator const& other) const
+            {
+                return it_ == other.it_;
+            }
+
+            bool
+            operator!=(const_iterator const& other) const
+            {
+                return it_ != other.it_;
+            }
+
+            reference
+            operator*() const
+            {
+                return *it_;
+            }
+
+            pointer
+            operator->() const
+            {
+                return &*it_;
+            }
+
+            const_iterator&
+            operator++()
+            {
+                ++it_;
+                return *this;
+            }
+
+            const_iterator
+            operator++(int)
+            {
+                auto temp = *this;
+                ++it_;
+                return temp;
+            }
+
+            const_iterator&
+            operator--()
+            {
+                --it_;
+                return *this;
+            }
+
+            const_iterator
+            operator--(int)
+            {
+                auto temp = *this;
+                --it_;
+                return temp;
+            }
+        };
+
+        explicit
+        bidirectional_buffers(list_type const& v)
+            : v_(&v)
+        {
+        }
+
+        const_iterator
+        begin() const
+        {
+            return const_iterator{v_->begin()};
+        }
+
+        const_iterator
+        end() const
+        {
+            return const_iterator{v_->end()};
+        }
+    };
+
+    // Consume one buffer at a time, presenting a prefix
+    // of what remains each time as a composed write does.
+    template<class BufferSequence>
+    static
+    std::size_t
+    drain(BufferSequence const& bs)
+    {
+        using boost::asio::buffer_size;
+        std::size_t total = 0;
+        consuming_buffers<BufferSequence> cb(bs);
+        for(;;)
+        {
+            auto const n = buffer_size(
+                prepare_buffers(2 * Size, cb));
+            if(n == 0)
+                break;
+            total += n;
+            cb.consume(Size);
+        }
+        return total;
+    }
+
+    template<class BufferSequence>
+    void
+    testSequence(std::string const& name,
+        std::size_t k, BufferSequence const& bs)
+    {
+        std::size_t total = 0;
+        // Each drain consumes k buffers
+        test::timed_test(log, 3, name + ", consume, " +
+            std::to_string(k) + " buffers",
+            [&]
+            {
+                for(std::size_t i = 0; i < N / k; ++i)
+                    total += drain(bs);
+            }, test::per_op{N});
+        // Copies of a sequence consumed past its middle,
+        // as made when an operation is moved or copied.
+        auto const pb = prepare_buffers(Size,
+            consumed_buffers(bs, k * Size / 2 + 1));
+        test::timed_test(log, 3, name + ", copy, " +
+            std::to_string(k) + " buffers",
+            [&]
+            {
+                for(std::size_t i = 0; i < N; ++i)
+                {
+                    auto const copy = pb;
+                    total += boost::asio::buffer_size(copy);
+                }
+            }, test::per_op{N});
+        BEAST_EXPECT(total > 0);
+    }
+
+    // Accepts at most a small number of bytes per call, so that
+    // writes walk the sequence several times, as on a slow peer.
+    class trickle_stream
+    {
+    public:
+        std::size_t bytes = 0;
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers,
+            error_code& ec)
+        {
+            ec = {};
+            auto const n = std::min<std::size_t>(
+                boost::asio::buffer_size(buffers), 128);
+            bytes += n;
+            return n;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            return write_some(buffers, ec);
+        }
+    };
+
+    // The pieces of a chunked HTTP write: headers,
+    // chunk size, body, and chunk delimiter.
+    void
+    testGather()
+    {
+        using boost::asio::const_buffers_1;
+        std::string const s(512, '*');
+        const_buffers_1 const h{&s[0], 200};
+        const_buffers_1 const c{&s[200], 5};
+        const_buffers_1 const d{&s[505], 2};
+        trickle_stream ts;
+        test::timed_test(log, 3, "gather, buffer_cat",
+            [&]
+            {
+                for(std::size_t i = 0; i < N; ++i)
+                {
+                    const_buffers_1 const b{&s[205], 1 + i % 300};
+                    boost::asio::write(ts,
+                        buffer_cat(h, c, b, d));
+                }
+            }, test::per_op{N});
+        test::timed_test(log, 3, "gather, static_buffer_sequence",
+            [&]
+            {
+                for(std::size_t i = 0; i < N; ++i)
+                {
+                    const_buffers_1 const b{&s[205], 1 + i % 300};
+                    boost::asio::write(ts,
+                        static_buffer_sequence<4>{h, c, b, d});
+                }
+            }, test::per_op{N});
+        BEAST_EXPECT(ts.bytes > 0);
+    }
+
+    void run() override
+    {
+        testGather();
+        std::string const s(1024 * Size, '*');
+        for(std::size_t k = 1; k <= 1024; k *= 4)
+        {
+            std::vector<boost::asio::const_buffer> v;
+            for(std::size_t i = 0; i < k; ++i)
+                v.push_back(boost::asio::const_buffer(
+                    &s[i * Size], Size));
+            testSequence("random access", k, v);
+            testSequence("buffer_cat", k, buffer_cat(
+                boost::asio::buffer(s.data(), 0),
+                    bidirectional_buffers{v}));
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(buffers_bench,core,beast);
+
+} // beast
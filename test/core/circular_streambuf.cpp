@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/circular_streambuf.hpp>
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<circular_streambuf>::value, "");
+
+class circular_streambuf_test : public beast::unit_test::suite
+{
+public:
+    template<class BufferSequence>
+    static
+    std::size_t
+    count(BufferSequence const& bs)
+    {
+        return std::distance(bs.begin(), bs.end());
+    }
+
+    void
+    testSpecialMembers()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::string const s = "Hello, world";
+        circular_streambuf sb(64, false);
+        sb.commit(buffer_copy(sb.prepare(s.size()), buffer(s)));
+        {
+            circular_streambuf sb2(std::move(sb));
+            BEAST_EXPECT(to_string(sb2.data()) == s);
+            BEAST_EXPECT(sb2.capacity() == 64);
+            BEAST_EXPECT(sb.size() == 0);
+            BEAST_EXPECT(sb.capacity() == 0);
+            sb = std::move(sb2);
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            BEAST_EXPECT(sb2.capacity() == 0);
+        }
+        try
+        {
+            circular_streambuf sb2(0);
+            fail();
+        }
+        catch(std::invalid_argument const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    testLimit(bool mirror)
+    {
+        circular_streambuf sb(16, mirror);
+        auto const cap = sb.capacity();
+        BEAST_EXPECT(cap >= 16);
+        BEAST_EXPECT(sb.max_size() == cap);
+        sb.commit(boost::asio::buffer_size(sb.prepare(cap)));
+        BEAST_EXPECT(sb.size() == cap);
+        try
+        {
+            sb.prepare(1);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(read_size_helper(sb, 65536) == 1);
+        sb.consume(10);
+        BEAST_EXPECT(read_size_helper(sb, 65536) == 10);
+        BEAST_EXPECT(read_size_helper(sb, 5) == 5);
+    }
+
+    // Fill and drain in steps which do not
+    // divide the capacity, so the sequences wrap.
+    void
+    testMatrix(bool mirror)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::string const s = "0123456789abcdefghijklmnopqrstuvwxyz";
+        for(std::size_t i = 1; i < 20; ++i)
+        {
+            circular_streambuf sb(23, mirror);
+            auto const cap = sb.capacity();
+            std::string t;
+            for(std::size_t j = 0; j < 3 * cap / i + 50; ++j)
+            {
+                auto const n = (std::min)(i, cap - sb.size());
+                auto const mb = sb.prepare(n);
+                if(mirror)
+                    BEAST_EXPECT(count(mb) == 1);
+                else
+                    BEAST_EXPECT(count(mb) <= 2);
+                auto const p = s.substr(j % s.size(), n);
+                sb.commit(buffer_copy(mb, buffer(p)));
+                t += p;
+                auto const cb = sb.data();
+                if(mirror)
+                    BEAST_EXPECT(count(cb) == 1);
+                BEAST_EXPECT(to_string(cb) == t);
+                auto const used = (j % 3) * i / 2;
+                sb.consume(used);
+                t.erase(0, used);
+                BEAST_EXPECT(to_string(sb.data()) == t);
+            }
+        }
+    }
+
+    // Bytes written past the end of the ring are visible at the front
+    void
+    testMirror()
+    {
+        using boost::asio::buffer_cast;
+        circular_streambuf sb(1);
+        if(! sb.mirrored())
+        {
+            log << "circular_streambuf: mirroring unavailable" << std::endl;
+            return;
+        }
+        auto const cap = sb.capacity();
+        sb.commit(boost::asio::buffer_size(sb.prepare(cap - 2)));
+        sb.consume(cap - 3);
+        auto const mb = sb.prepare(4);
+        auto const p = buffer_cast<char*>(*mb.begin());
+        std::copy_n("abcd", 4, p);
+        sb.commit(4);
+        BEAST_EXPECT(to_string(sb.data()).substr(1) == "abcd");
+        sb.consume(3);
+        auto const q = buffer_cast<char const*>(*sb.data().begin());
+        BEAST_EXPECT(q == buffer_cast<char const*>(
+            *sb.prepare(0).begin()) - 2);
+        BEAST_EXPECT(std::string(q, 2) == "cd");
+    }
+
+    void run() override
+    {
+        testSpecialMembers();
+        for(bool mirror : {true, false})
+        {
+            testLimit(mirror);
+            testMatrix(mirror);
+        }
+        testMirror();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(circular_streambuf,core,beast);
+
+} // beast
@@ -70,6 +70,16 @@ public:
             cb.consume(y);
             BEAST_EXPECT(to_string(cb) == s.substr(x+y));
             BEAST_EXPECT(eq(cb, consumed_buffers(bs, x+y)));
+            {
+                auto cb2 = cb;
+                BEAST_EXPECT(to_string(cb2) == s.substr(x+y));
+                cb2 = consumed_buffers(bs, x);
+                BEAST_EXPECT(to_string(cb2) == s.substr(x));
+                cb2 = cb;
+                BEAST_EXPECT(to_string(cb2) == s.substr(x+y));
+                auto cb3 = std::move(cb2);
+                BEAST_EXPECT(to_string(cb3) == s.substr(x+y));
+            }
             cb.consume(z);
             BEAST_EXPECT(to_string(cb) == "");
             BEAST_EXPECT(eq(cb, consumed_buffers(bs, x+y+z)));
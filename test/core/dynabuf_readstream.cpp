@@ -9,6 +9,7 @@
 #include <beast/core/dynabuf_readstream.hpp>
 
 #include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/test/fail_stream.hpp>
 #include <beast/test/string_stream.hpp>
 #include <beast/test/yield_to.hpp>
@@ -128,12 +129,111 @@ public:
         BEAST_EXPECT(n < limit);
     }
 
+    void testFill(yield_context do_yield)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        static std::size_t constexpr limit = 100;
+        std::size_t n;
+
+        for(n = 0; n < limit; ++n)
+        {
+            test::fail_stream<
+                test::string_stream> fs(n, ios_, ", world!");
+            dynabuf_readstream<
+                decltype(fs)&, streambuf> srs(fs);
+            srs.buffer().commit(buffer_copy(
+                srs.buffer().prepare(5), buffer("Hello", 5)));
+            error_code ec;
+            srs.fill(13, ec);
+            if(! ec)
+            {
+                BEAST_EXPECT(to_string(
+                    srs.buffered_data()) == "Hello, world!");
+                break;
+            }
+        }
+        BEAST_EXPECT(n < limit);
+
+        for(n = 0; n < limit; ++n)
+        {
+            test::fail_stream<
+                test::string_stream> fs(n, ios_, ", world!");
+            dynabuf_readstream<
+                decltype(fs)&, streambuf> srs(fs);
+            srs.capacity(3);
+            error_code ec;
+            srs.async_fill(8, do_yield[ec]);
+            if(! ec)
+            {
+                BEAST_EXPECT(to_string(
+                    srs.buffered_data()) == ", world!");
+                // already buffered
+                srs.async_fill(4, do_yield[ec]);
+                BEAST_EXPECT(! ec);
+                BEAST_EXPECT(srs.buffer().size() == 8);
+                break;
+            }
+        }
+        BEAST_EXPECT(n < limit);
+
+        {
+            test::string_stream ss(ios_, "Hello");
+            dynabuf_readstream<
+                test::string_stream&, streambuf> srs(ss);
+            error_code ec;
+            srs.async_fill(6, do_yield[ec]);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+            BEAST_EXPECT(to_string(
+                srs.buffered_data()) == "Hello");
+        }
+    }
+
+    void testReadAhead()
+    {
+        using boost::asio::buffer;
+        // read-ahead sizes 512 through 8192, one direct
+        // read of 8192, then a short tail of 100 bytes.
+        std::string const s(15872 + 8192 + 100, '*');
+        test::string_stream ss(ios_, s);
+        dynabuf_readstream<
+            test::string_stream&, streambuf> srs(ss);
+        BEAST_EXPECT(srs.read_size() == 0);
+        srs.capacity(8192);
+        BEAST_EXPECT(srs.read_size() == 512);
+        char c;
+        // each read which fills the read-ahead doubles it
+        for(std::size_t size = 512; size <= 8192; size *= 2)
+        {
+            BEAST_EXPECT(srs.read_size() == size);
+            srs.read_some(buffer(&c, 1));
+            BEAST_EXPECT(srs.buffer().size() == size - 1);
+            srs.buffer().consume(size);
+        }
+        BEAST_EXPECT(srs.read_size() == 8192);
+        // large reads bypass the buffer
+        std::string t(8192, ' ');
+        BEAST_EXPECT(srs.read_some(
+            buffer(&t[0], t.size())) == t.size());
+        BEAST_EXPECT(srs.buffer().size() == 0);
+        BEAST_EXPECT(srs.read_size() == 8192);
+        // short reads shrink it
+        srs.read_some(buffer(&c, 1));
+        BEAST_EXPECT(srs.buffer().size() == 99);
+        BEAST_EXPECT(srs.read_size() == 4096);
+    }
+
     void run() override
     {
         testSpecialMembers();
 
         yield_to(std::bind(&self::testRead,
             this, std::placeholders::_1));
+
+        yield_to(std::bind(&self::testFill,
+            this, std::placeholders::_1));
+
+        testReadAhead();
     }
 };
 
@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/flat_streambuf.hpp>
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<flat_streambuf>::value, "");
+
+class flat_streambuf_test : public beast::unit_test::suite
+{
+public:
+    template<class U, class V>
+    static
+    void
+    self_assign(U& u, V&& v)
+    {
+        u = std::forward<V>(v);
+    }
+
+    void
+    testSpecialMembers()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::string const s = "Hello, world";
+        for(std::size_t x = 1; x < 4; ++x) {
+        for(std::size_t y = 1; y < 4; ++y) {
+        std::size_t z = s.size() - (x + y);
+        {
+            flat_streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(x), buffer(s.data(), x)));
+            sb.commit(buffer_copy(sb.prepare(y), buffer(s.data()+x, y)));
+            sb.commit(buffer_copy(sb.prepare(z), buffer(s.data()+x+y, z)));
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            {
+                flat_streambuf sb2(sb);
+                BEAST_EXPECT(to_string(sb2.data()) == s);
+            }
+            {
+                flat_streambuf sb2;
+                sb2 = sb;
+                BEAST_EXPECT(to_string(sb2.data()) == s);
+            }
+            {
+                flat_streambuf sb2(std::move(sb));
+                BEAST_EXPECT(to_string(sb2.data()) == s);
+                BEAST_EXPECT(sb.size() == 0);
+                BEAST_EXPECT(sb.capacity() == 0);
+                sb = std::move(sb2);
+                BEAST_EXPECT(to_string(sb.data()) == s);
+                BEAST_EXPECT(sb2.size() == 0);
+            }
+            self_assign(sb, sb);
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            self_assign(sb, std::move(sb));
+            BEAST_EXPECT(to_string(sb.data()) == s);
+        }
+        }}
+    }
+
+    void
+    testPrepare()
+    {
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        flat_streambuf sb;
+        BEAST_EXPECT(sb.capacity() == 0);
+        BEAST_EXPECT(buffer_size(sb.prepare(5)) == 5);
+        BEAST_EXPECT(sb.capacity() == 5);
+        BEAST_EXPECT(buffer_size(sb.prepare(3)) == 3);
+        BEAST_EXPECT(sb.capacity() == 5);
+        sb << "12345";
+        BEAST_EXPECT(sb.capacity() == 5);
+        sb << "6789";
+        BEAST_EXPECT(sb.capacity() == 10);
+        BEAST_EXPECT(to_string(sb.data()) == "123456789");
+
+        // The input is moved to the front when that makes room
+        auto const p = buffer_cast<char const*>(*sb.data().begin());
+        sb.consume(5);
+        sb << "abcde";
+        BEAST_EXPECT(sb.capacity() == 10);
+        BEAST_EXPECT(buffer_cast<char const*>(*sb.data().begin()) == p);
+        BEAST_EXPECT(to_string(sb.data()) == "6789abcde");
+
+        // Growth is geometric
+        sb << std::string(12, '*');
+        BEAST_EXPECT(sb.capacity() == 21);
+        sb << "**";
+        BEAST_EXPECT(sb.capacity() == 42);
+        BEAST_EXPECT(sb.size() == 23);
+
+        // Consuming everything starts over at the front
+        sb.consume(100);
+        BEAST_EXPECT(sb.size() == 0);
+        BEAST_EXPECT(buffer_size(sb.prepare(42)) == 42);
+        BEAST_EXPECT(sb.capacity() == 42);
+
+        sb.shrink_to_fit();
+        BEAST_EXPECT(sb.capacity() == 0);
+        sb.reserve(100);
+        BEAST_EXPECT(sb.capacity() == 100);
+        sb << "x";
+        sb.shrink_to_fit();
+        BEAST_EXPECT(sb.capacity() == 1);
+        BEAST_EXPECT(to_string(sb.data()) == "x");
+    }
+
+    void
+    testLimit()
+    {
+        flat_streambuf sb(16);
+        BEAST_EXPECT(sb.max_size() == 16);
+        sb << "0123456789";
+        sb << "012345";
+        BEAST_EXPECT(sb.capacity() == 16);
+        try
+        {
+            sb.prepare(1);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        sb.consume(1);
+        sb.prepare(1);
+        try
+        {
+            sb.reserve(17);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(read_size_helper(sb, 65536) == 1);
+        sb.commit(1);
+        BEAST_EXPECT(read_size_helper(sb, 65536) == 0);
+    }
+
+    void
+    testMatrix()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::string const s = "Hello, world";
+        for(std::size_t i = 1; i < s.size(); ++i)
+        {
+            flat_streambuf sb(s.size());
+            std::string t;
+            for(std::size_t j = 0; j < 10 * s.size(); j += i)
+            {
+                auto const n = (std::min)(i, s.size() - sb.size());
+                sb.commit(buffer_copy(sb.prepare(n),
+                    buffer(s.data() + j % s.size(),
+                        (std::min)(n, s.size() - j % s.size()))));
+                t = to_string(sb.data());
+                auto const used = (j / i) % 3;
+                sb.consume(used);
+                t.erase(0, used);
+                BEAST_EXPECT(to_string(sb.data()) == t);
+            }
+        }
+    }
+
+    void run() override
+    {
+        testSpecialMembers();
+        testPrepare();
+        testLimit();
+        testMatrix();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(flat_streambuf,core,beast);
+
+} // beast
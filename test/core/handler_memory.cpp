@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/handler_memory.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+
+namespace beast {
+
+class handler_memory_test : public unit_test::suite
+{
+public:
+    void
+    testRecycle()
+    {
+        handler_memory m(2);
+        auto const p = m.allocate(100);
+        m.deallocate(p, 100);
+        BEAST_EXPECT(m.size() == 1);
+        BEAST_EXPECT(m.allocate(50) == p);
+        BEAST_EXPECT(m.size() == 0);
+        auto const q = m.allocate(200);
+        BEAST_EXPECT(q != p);
+        auto const r = m.allocate(10);
+        m.deallocate(p, 50);
+        m.deallocate(q, 200);
+        m.deallocate(r, 10);
+        BEAST_EXPECT(m.size() == 2);
+        // The first block which fits is used
+        BEAST_EXPECT(m.allocate(150) == q);
+    }
+
+    void
+    testHandler()
+    {
+        boost::asio::io_service ios;
+        handler_memory m;
+        int n = 0;
+        ios.post(bind_memory(m, [&]{ ++n; }));
+        ios.run();
+        BEAST_EXPECT(n == 1);
+        BEAST_EXPECT(m.size() == 1);
+        ios.reset();
+        ios.post(bind_memory(m, [&]{ ++n; }));
+        BEAST_EXPECT(m.size() == 0);
+        ios.run();
+        BEAST_EXPECT(n == 2);
+        BEAST_EXPECT(m.size() == 1);
+    }
+
+    void run() override
+    {
+        testRecycle();
+        testHandler();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(handler_memory,core,beast);
+
+} // beast
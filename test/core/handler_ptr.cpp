@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/handler_ptr.hpp>
+
+#include <beast/core/handler_memory.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <functional>
+#include <utility>
+
+namespace beast {
+
+class handler_ptr_test : public unit_test::suite
+{
+public:
+    struct data
+    {
+        int& live;
+        int v;
+
+        template<class Handler>
+        data(Handler&, int& live_, int v_)
+            : live(live_)
+            , v(v_)
+        {
+            ++live;
+        }
+
+        ~data()
+        {
+            --live;
+        }
+    };
+
+    void
+    testInvoke()
+    {
+        handler_memory m;
+        int live = 0;
+        int n = 0;
+        auto h = bind_memory(m,
+            [&](int v)
+            {
+                // state is gone before the upcall
+                BEAST_EXPECT(live == 0);
+                BEAST_EXPECT(m.size() == 1);
+                n += v;
+            });
+        {
+            handler_ptr<data, decltype(h)> p(h, live, 42);
+            BEAST_EXPECT(live == 1);
+            BEAST_EXPECT(m.size() == 0);
+            BEAST_EXPECT(p->v == 42);
+            BEAST_EXPECT(p.get() == &*p);
+            auto p2 = std::move(p);
+            BEAST_EXPECT(p2->v == 42);
+            p2.invoke(p2->v);
+            BEAST_EXPECT(p2.get() == nullptr);
+        }
+        BEAST_EXPECT(n == 42);
+        BEAST_EXPECT(live == 0);
+        BEAST_EXPECT(m.size() == 1);
+    }
+
+    void
+    testDestroy()
+    {
+        handler_memory m;
+        int live = 0;
+        auto h = bind_memory(m, []{});
+        {
+            handler_ptr<data, decltype(h)> p(h, live, 1);
+            BEAST_EXPECT(live == 1);
+        }
+        BEAST_EXPECT(live == 0);
+        BEAST_EXPECT(m.size() == 1);
+    }
+
+    void
+    testCopy()
+    {
+        int live = 0;
+        int n = 0;
+        std::function<void()> h = [&]{ ++n; };
+        handler_ptr<data, std::function<void()>> p(h, live, 1);
+        {
+            auto p2 = p;
+            BEAST_EXPECT(&*p2 == &*p);
+            p2->v = 2;
+        }
+        BEAST_EXPECT(live == 1);
+        BEAST_EXPECT(p->v == 2);
+        auto p3 = p;
+        auto f = p.release_handler();
+        BEAST_EXPECT(live == 0);
+        BEAST_EXPECT(p.get() == nullptr);
+        BEAST_EXPECT(p3.get() == nullptr);
+        f();
+        BEAST_EXPECT(n == 1);
+    }
+
+    void run() override
+    {
+        testInvoke();
+        testDestroy();
+        testCopy();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(handler_ptr,core,beast);
+
+} // beast
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/static_buffer_sequence.hpp>
+
+#include <beast/core/buffer_cat.hpp>
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace beast {
+
+static_assert(is_ConstBufferSequence<
+    static_buffer_sequence<3>>::value, "");
+
+class static_buffer_sequence_test : public unit_test::suite
+{
+public:
+    void
+    testAppend()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_size;
+        std::string const s = "Hello, world";
+        static_buffer_sequence<3> sb;
+        BEAST_EXPECT(sb.size() == 0);
+        BEAST_EXPECT(sb.capacity() == 3);
+        BEAST_EXPECT(sb.begin() == sb.end());
+        sb.push_back(buffer(&s[0], 5));
+        // empty buffers are not stored
+        sb.push_back(buffer(&s[5], 0));
+        sb.append(buffer_cat(
+            buffer(&s[5], 2), buffer(&s[7], 5)));
+        BEAST_EXPECT(sb.size() == 3);
+        BEAST_EXPECT(to_string(sb) == s);
+        try
+        {
+            sb.push_back(buffer(s));
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        sb.clear();
+        sb.push_back(buffer(&s[0], 5));
+        try
+        {
+            // does not fit, nothing is appended
+            sb.append(buffer_cat(
+                buffer(&s[5], 2), buffer(&s[7], 2),
+                    buffer(&s[9], 3)));
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(sb.size() == 1);
+        BEAST_EXPECT(to_string(sb) == "Hello");
+    }
+
+    void
+    testConstruct()
+    {
+        using boost::asio::buffer;
+        std::string const s = "Hello, world";
+        char buf[7];
+        boost::asio::buffer_copy(buffer(buf), buffer(&s[5], 7));
+        static_buffer_sequence<2> sb{
+            buffer(&s[0], 5), buffer(buf)};
+        BEAST_EXPECT(to_string(sb) == s);
+        auto sb2 = sb;
+        BEAST_EXPECT(to_string(sb2) == s);
+        static_buffer_sequence<2> sb3;
+        sb3 = sb2;
+        BEAST_EXPECT(sb3.size() == 2);
+        BEAST_EXPECT(to_string(sb3) == s);
+    }
+
+    void run() override
+    {
+        testAppend();
+        testConstruct();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(static_buffer_sequence,core,beast);
+
+} // beast
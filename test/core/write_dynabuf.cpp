@@ -8,15 +8,30 @@
 // Test that header file is self-contained.
 #include <beast/core/write_dynabuf.hpp>
 
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/static_string.hpp>
 #include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/unit_test/suite.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <limits>
 
 namespace beast {
 
 class write_dynabuf_test : public beast::unit_test::suite
 {
 public:
-    void run() override
+    template<class DynamicBuffer, class... Args>
+    std::string
+    str(DynamicBuffer&& dynabuf, Args const&... args)
+    {
+        write(dynabuf, args...);
+        return to_string(dynabuf.data());
+    }
+
+    void
+    testBuffers()
     {
         streambuf sb;
         std::string s;
@@ -27,7 +42,57 @@ public:
         write(sb, boost::asio::mutable_buffers_1{nullptr, 0});
         write(sb, s);
         write(sb, 23);
-        pass();
+        BEAST_EXPECT(to_string(sb.data()) == "23");
+    }
+
+    void
+    testIntegers()
+    {
+        BEAST_EXPECT(str(streambuf{}, 0) == "0");
+        BEAST_EXPECT(str(streambuf{}, 42u) == "42");
+        BEAST_EXPECT(str(streambuf{}, -1) == "-1");
+        BEAST_EXPECT(str(streambuf{}, short{-300}) == "-300");
+        BEAST_EXPECT(str(streambuf{},
+            std::numeric_limits<std::uint64_t>::max()) ==
+                "18446744073709551615");
+        BEAST_EXPECT(str(streambuf{},
+            std::numeric_limits<std::int64_t>::min()) ==
+                "-9223372036854775808");
+        BEAST_EXPECT(str(flat_streambuf{},
+            std::numeric_limits<std::int64_t>::max()) ==
+                "9223372036854775807");
+        // characters and bool are not formatted as numbers
+        BEAST_EXPECT(str(streambuf{}, 'x') == "x");
+        BEAST_EXPECT(str(streambuf{}, true) == "1");
+        {
+            // prepared memory spans several blocks
+            streambuf sb(4);
+            BEAST_EXPECT(str(sb, "HTTP/1.1 ",
+                -1234567890123456789LL, " ", 200) ==
+                    "HTTP/1.1 -1234567890123456789 200");
+        }
+    }
+
+    void
+    testStrings()
+    {
+        BEAST_EXPECT(str(streambuf{}, "Hello") == "Hello");
+        BEAST_EXPECT(str(streambuf{},
+            boost::string_ref{"Hello, world", 5}) == "Hello");
+        BEAST_EXPECT(str(streambuf{},
+            boost::string_ref{}) == "");
+        static_string<8> ss{"Hello"};
+        BEAST_EXPECT(str(streambuf{}, ss, ", ", ss) ==
+            "Hello, Hello");
+        char const* p = "world";
+        BEAST_EXPECT(str(streambuf{}, p) == "world");
+    }
+
+    void run() override
+    {
+        testBuffers();
+        testIntegers();
+        testStrings();
     }
 };
 
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http/read.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/http/write.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/test/counting_allocator.hpp>
+#include <beast/test/fail_stream.hpp>
+#include <beast/test/string_stream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class allocations_test : public beast::unit_test::suite
+{
+public:
+    using counting_streambuf = basic_streambuf<
+        test::counting_allocator<char>>;
+
+    using counting_flat_streambuf = basic_flat_streambuf<
+        test::counting_allocator<char>>;
+
+    using counting_headers = basic_headers<
+        test::counting_allocator<char>>;
+
+    using request_type = request<string_body, counting_headers>;
+
+    // Number of messages in each loop
+    static std::size_t constexpr N = 100;
+
+    static
+    std::string
+    requests()
+    {
+        std::string s;
+        for(std::size_t i = 0; i < N; ++i)
+            s.append(
+                "POST / HTTP/1.1\r\n"
+                "Host: localhost\r\n"
+                "User-Agent: test\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****");
+        return s;
+    }
+
+    static
+    request_type
+    make_request()
+    {
+        request_type req;
+        req.method = "POST";
+        req.url = "/";
+        req.version = 11;
+        req.headers.insert("Host", "localhost");
+        req.headers.insert("User-Agent", "test");
+        req.body = "*****";
+        prepare(req);
+        return req;
+    }
+
+    // Reads every message, checking that each field of a message
+    // read into new headers is one allocation. Returns the number
+    // of buffer allocations after the first message.
+    template<class DynamicBuffer>
+    std::size_t
+    read_all(DynamicBuffer& sb, test::allocation_counter& bc)
+    {
+        boost::asio::io_service ios;
+        auto& hc = test::default_allocation_counter();
+        test::string_stream ss(ios, requests());
+        std::size_t n = 0;
+        std::size_t peak = 0;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            hc.reset();
+            bc.reset();
+            {
+                request_type req;
+                read(ss, sb, req);
+                BEAST_EXPECT(req.body == "*****");
+                BEAST_EXPECT(hc.allocations == 3);
+                if(i == 0)
+                    peak = hc.peak;
+                else
+                    BEAST_EXPECT(hc.peak == peak);
+            }
+            BEAST_EXPECT(hc.live == 0);
+            if(i > 0)
+                n += bc.allocations;
+        }
+        return n;
+    }
+
+    void
+    testRead()
+    {
+        test::allocation_counter bc;
+        {
+            // A flat buffer, once grown, is reused.
+            counting_flat_streambuf sb(8192,
+                test::counting_allocator<char>(bc));
+            BEAST_EXPECT(read_all(sb, bc) == 0);
+        }
+        {
+            // The block list allocates a block each
+            // time the input crosses a block boundary.
+            counting_streambuf sb(1024,
+                test::counting_allocator<char>(bc));
+            BEAST_EXPECT(read_all(sb, bc) <=
+                requests().size() / 1024 + 1);
+        }
+    }
+
+    // The operation allocates a fixed number of times
+    // per message, and frees everything before the upcall.
+    void
+    testAsyncRead()
+    {
+        boost::asio::io_service ios;
+        test::allocation_counter c;
+        test::fail_stream<test::string_stream> fs(
+            4 * N, ios, requests());
+        streambuf sb;
+        std::size_t peak = 0;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            c.reset();
+            request_type req;
+            error_code result = boost::asio::error::fault;
+            async_read(fs, sb, req, test::bind_counter(c,
+                [&](error_code const& ec)
+                {
+                    BEAST_EXPECT(c.live == 0);
+                    result = ec;
+                }));
+            ios.run();
+            ios.reset();
+            BEAST_EXPECTS(! result, result.message());
+            BEAST_EXPECT(c.allocations <= 3);
+            BEAST_EXPECT(c.deallocations == c.allocations);
+            if(i == 0)
+                peak = c.peak;
+            else
+                BEAST_EXPECT(c.peak == peak);
+        }
+    }
+
+    // Serializing headers does not allocate through their
+    // allocator, and async_write allocates a fixed number
+    // of times per message.
+    void
+    testWrite()
+    {
+        boost::asio::io_service ios;
+        auto& hc = test::default_allocation_counter();
+        auto const req = make_request();
+        test::fail_stream<test::string_stream> fs(
+            4 * N, ios, "");
+        test::allocation_counter c;
+        std::size_t peak = 0;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            hc.reset();
+            write(fs, req);
+            BEAST_EXPECT(hc.allocations == 0);
+            c.reset();
+            error_code result = boost::asio::error::fault;
+            async_write(fs, req, test::bind_counter(c,
+                [&](error_code const& ec)
+                {
+                    BEAST_EXPECT(c.live == 0);
+                    result = ec;
+                }));
+            ios.run();
+            ios.reset();
+            BEAST_EXPECTS(! result, result.message());
+            BEAST_EXPECT(hc.allocations == 0);
+            BEAST_EXPECT(c.allocations <= 2);
+            BEAST_EXPECT(c.deallocations == c.allocations);
+            if(i == 0)
+                peak = c.peak;
+            else
+                BEAST_EXPECT(c.peak == peak);
+        }
+    }
+
+    void
+    run() override
+    {
+        testRead();
+        testAsyncRead();
+        testWrite();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(allocations,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http.hpp>
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/test/timed_test.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <string>
+#include <utility>
+
+namespace beast {
+namespace http {
+
+// Measures the cost of the composed operations
+// themselves, using a stream which completes
+// each operation immediately.
+class async_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr N = 200000;
+
+    // Reads from a string without erasing it, and
+    // discards writes. Completions are posted.
+    class corpus_stream
+    {
+        boost::asio::io_service& ios_;
+        std::string const& s_;
+        std::size_t pos_ = 0;
+
+    public:
+        corpus_stream(boost::asio::io_service& ios,
+                std::string const& s)
+            : ios_(ios)
+            , s_(s)
+        {
+        }
+
+        boost::asio::io_service&
+        get_io_service()
+        {
+            return ios_;
+        }
+
+        template<class MutableBufferSequence, class ReadHandler>
+        void
+        async_read_some(MutableBufferSequence const& buffers,
+            ReadHandler&& handler)
+        {
+            auto const n = boost::asio::buffer_copy(buffers,
+                boost::asio::buffer(s_.data() + pos_, s_.size() - pos_));
+            error_code ec;
+            if(n == 0)
+                ec = boost::asio::error::eof;
+            pos_ += n;
+            ios_.post(bind_handler(
+                std::forward<ReadHandler>(handler), ec, n));
+        }
+
+        template<class ConstBufferSequence, class WriteHandler>
+        void
+        async_write_some(ConstBufferSequence const& buffers,
+            WriteHandler&& handler)
+        {
+            ios_.post(bind_handler(std::forward<WriteHandler>(handler),
+                error_code{}, boost::asio::buffer_size(buffers)));
+        }
+    };
+
+    struct read_loop
+    {
+        corpus_stream& s;
+        streambuf& sb;
+        request<string_body>& m;
+        std::size_t& n;
+
+        void
+        operator()(error_code const& ec)
+        {
+            if(ec || ++n == N)
+                return;
+            async_read(s, sb, m, *this);
+        }
+    };
+
+    struct write_loop
+    {
+        corpus_stream& s;
+        response<string_body> const& m;
+        std::size_t& n;
+
+        void
+        operator()(error_code const& ec)
+        {
+            if(ec || ++n == N)
+                return;
+            async_write(s, m, *this);
+        }
+    };
+
+    void
+    testRead()
+    {
+        std::string const s =
+            "GET / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****";
+        std::string corpus;
+        corpus.reserve(N * s.size());
+        for(std::size_t i = 0; i < N; ++i)
+            corpus += s;
+        test::timed_test(log, 3, "async_read",
+            [&]
+            {
+                boost::asio::io_service ios;
+                corpus_stream ss(ios, corpus);
+                streambuf sb;
+                request<string_body> m;
+                std::size_t n = 0;
+                async_read(ss, sb, m, read_loop{ss, sb, m, n});
+                ios.run();
+                BEAST_EXPECT(n == N);
+            }, test::per_op{N});
+    }
+
+    void
+    testWrite()
+    {
+        response<string_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Server", "async_bench");
+        m.body = "Hello, world!";
+        prepare(m);
+        std::string const empty;
+        test::timed_test(log, 3, "async_write",
+            [&]
+            {
+                boost::asio::io_service ios;
+                corpus_stream ss(ios, empty);
+                std::size_t n = 0;
+                async_write(ss, m, write_loop{ss, m, n});
+                ios.run();
+                BEAST_EXPECT(n == N);
+            }, test::per_op{N});
+    }
+
+    void run() override
+    {
+        testcase << N << " operations";
+        testRead();
+        testWrite();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(async_bench,http,beast);
+
+} // http
+} // beast
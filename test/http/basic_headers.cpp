@@ -82,10 +82,27 @@ public:
         BEAST_EXPECT(h.size() == 2);
     }
 
+    void testNumbers()
+    {
+        bh h;
+        h.insert("Content-Length", 12345u);
+        h.insert("Age", 0);
+        h.insert("X-Offset", -42L);
+        h.insert("X-Ratio", 0.5);
+        BEAST_EXPECT(h["Content-Length"] == "12345");
+        BEAST_EXPECT(h["Age"] == "0");
+        BEAST_EXPECT(h["X-Offset"] == "-42");
+        BEAST_EXPECT(h["X-Ratio"] == "0.5");
+        h.replace("Content-Length", std::uint64_t{1} << 40);
+        BEAST_EXPECT(h.count("Content-Length") == 1);
+        BEAST_EXPECT(h["Content-Length"] == "1099511627776");
+    }
+
     void run() override
     {
         testHeaders();
         testRFC2616();
+        testNumbers();
     }
 };
 
@@ -1153,6 +1153,127 @@ public:
         }
     }
 
+    //--------------------------------------------------------------------------
+
+    struct strict_policy : parser_policy
+    {
+        static bool constexpr obs_fold = false;
+        static bool constexpr chunked = false;
+        static bool constexpr upgrade = false;
+    };
+
+    template<bool isRequest, class Policy>
+    struct policy_parser
+        : basic_parser_v1<isRequest,
+            policy_parser<isRequest, Policy>, Policy>
+    {
+        std::string body;
+
+        void on_start(error_code&) {}
+        void on_method(boost::string_ref const&, error_code&) {}
+        void on_uri(boost::string_ref const&, error_code&) {}
+        void on_reason(boost::string_ref const&, error_code&) {}
+        void on_request(error_code&) {}
+        void on_response(error_code&) {}
+        void on_field(boost::string_ref const&, error_code&) {}
+        void on_value(boost::string_ref const&, error_code&) {}
+        void on_headers(std::uint64_t, error_code&) {}
+        body_what on_body_what(std::uint64_t, error_code&)
+        {
+            return body_what::normal;
+        }
+        void on_body(boost::string_ref const& s, error_code&)
+        {
+            body.append(s.data(), s.size());
+        }
+        void on_complete(error_code&) {}
+    };
+
+    void testPolicy()
+    {
+        using boost::asio::buffer;
+        auto const parse =
+            [](policy_parser<true, strict_policy>& p,
+                std::string const& s)
+            {
+                error_code ec;
+                p.write(buffer(s), ec);
+                return ec;
+            };
+        {
+            policy_parser<true, strict_policy> p;
+            BEAST_EXPECT(parse(p,
+                "GET / HTTP/1.1\r\n"
+                "User-Agent: x\r\n"
+                " y\r\n"
+                "\r\n") == parse_error::illegal_obs_fold);
+        }
+        {
+            policy_parser<true, strict_policy> p;
+            BEAST_EXPECT(parse(p,
+                "GET / HTTP/1.1\r\n"
+                "User-Agent:\r\n"
+                " y\r\n"
+                "\r\n") == parse_error::illegal_obs_fold);
+        }
+        {
+            policy_parser<true, strict_policy> p;
+            BEAST_EXPECT(parse(p,
+                "POST / HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "1\r\n"
+                "*\r\n"
+                "0\r\n"
+                "\r\n") == parse_error::illegal_transfer_encoding);
+        }
+        for(auto const field : {
+            "Transfer-Encoding-Hint: x\r\n",
+            "Transfer-Encodings: x\r\n"})
+        {
+            policy_parser<true, strict_policy> p;
+            auto const ec = parse(p,
+                std::string{"GET / HTTP/1.1\r\n"} + field + "\r\n");
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+        }
+        {
+            policy_parser<true, strict_policy> p;
+            auto const ec = parse(p,
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 1\r\n"
+                "\r\n"
+                "*");
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.body == "*");
+        }
+        {
+            policy_parser<true, strict_policy> p;
+            auto const ec = parse(p,
+                "GET / HTTP/1.1\r\n"
+                "Connection: upgrade\r\n"
+                "Upgrade: WebSocket\r\n"
+                "\r\n");
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(! p.upgrade());
+        }
+        {
+            policy_parser<true, parser_policy> p;
+            error_code ec;
+            p.write(buffer(std::string{
+                "GET / HTTP/1.1\r\n"
+                "Connection: upgrade\r\n"
+                "Upgrade: WebSocket\r\n"
+                "User-Agent: x\r\n"
+                " y\r\n"
+                "\r\n"}), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.upgrade());
+        }
+    }
+
     void run() override
     {
         testCallbacks();
@@ -1166,6 +1287,7 @@ public:
         testBody();
         testChunkedBody();
         testLimits();
+        testPolicy();
     }
 };
 
@@ -74,8 +74,37 @@ public:
         BEAST_EXPECT(s == answer);
     }
 
+    void
+    testLast()
+    {
+        using boost::asio::buffer;
+        auto const enc =
+            [](bool last, std::string const& s)
+            {
+                return to_string(chunk_encode(
+                    last, buffer(s.data(), s.size())));
+            };
+        BEAST_EXPECT(enc(false, "") == "");
+        BEAST_EXPECT(enc(true, "") == "0\r\n\r\n");
+        BEAST_EXPECT(enc(false, "***") == "3\r\n***\r\n");
+        BEAST_EXPECT(enc(true, "***") ==
+            "3\r\n***\r\n0\r\n\r\n");
+        {
+            // copies refer to their own chunk header
+            auto const c1 = chunk_encode(true, buffer("**", 2));
+            auto c2 = c1;
+            BEAST_EXPECT(to_string(c2) ==
+                "2\r\n**\r\n0\r\n\r\n");
+            auto const c3 = chunk_encode(false, buffer("", 0));
+            auto c4 = c3;
+            BEAST_EXPECT(to_string(c4) == "");
+        }
+    }
+
     void run() override
     {
+        testLast();
+
         check(
             "0\r\n\r\n"
             "0\r\n\r\n",
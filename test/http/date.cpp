@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/date.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class date_test : public unit_test::suite
+{
+public:
+    static
+    std::string
+    str(std::time_t t)
+    {
+        char buf[date_size];
+        auto const end = format_date(buf, t);
+        return std::string(buf, end);
+    }
+
+    void
+    testFormat()
+    {
+        BEAST_EXPECT(str(0) == "Thu, 01 Jan 1970 00:00:00 GMT");
+        BEAST_EXPECT(str(784111777) == "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(str(951782400) == "Tue, 29 Feb 2000 00:00:00 GMT");
+        BEAST_EXPECT(str(1483228799) == "Sat, 31 Dec 2016 23:59:59 GMT");
+        BEAST_EXPECT(str(-1) == "Wed, 31 Dec 1969 23:59:59 GMT");
+    }
+
+    void
+    testCurrent()
+    {
+        char buf[date_size];
+        auto const before = str(std::time(nullptr));
+        auto const end = current_date(buf);
+        auto const after = str(std::time(nullptr));
+        BEAST_EXPECT(end == buf + date_size);
+        std::string const s(buf, end);
+        BEAST_EXPECT(s == before || s == after);
+    }
+
+    // Readers on many threads must always see a whole date
+    void
+    testThreads()
+    {
+        std::atomic<bool> ok{true};
+        std::vector<std::thread> v;
+        for(int i = 0; i < 4; ++i)
+            v.emplace_back(
+                [&]
+                {
+                    char buf[date_size];
+                    for(int j = 0; j < 100000; ++j)
+                    {
+                        current_date(buf);
+                        if(std::string(buf + 25, 4) != " GMT" ||
+                                buf[3] != ',')
+                            ok = false;
+                    }
+                });
+        for(auto& t : v)
+            t.join();
+        BEAST_EXPECT(ok);
+    }
+
+    void run() override
+    {
+        testFormat();
+        testCurrent();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(date,http,beast);
+
+} // http
+} // beast
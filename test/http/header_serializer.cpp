@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/header_serializer.hpp>
+
+#include <beast/http/empty_body.hpp>
+#include <beast/http/headers.hpp>
+#include <beast/http/reason.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class header_serializer_test : public beast::unit_test::suite
+{
+public:
+    template<bool isRequest, class Body, class Headers>
+    static
+    std::string
+    str(header_serializer& hs,
+        message<isRequest, Body, Headers> const& m)
+    {
+        hs.serialize(m);
+        return to_string(hs.data());
+    }
+
+    void
+    testRequest()
+    {
+        header_serializer hs;
+        request<empty_body> m;
+        m.verb = verb::get;
+        m.url = "/";
+        m.version = 11;
+        m.headers.insert("Host", "localhost");
+        m.headers.insert("User-Agent", "test");
+        BEAST_EXPECT(str(hs, m) ==
+            "GET / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "User-Agent: test\r\n"
+            "\r\n");
+        BEAST_EXPECT(hs.size() ==
+            header_serializer::serialized_size(m));
+        m.verb = verb::unknown;
+        m.method = "BREW";
+        m.version = 10;
+        m.headers.erase("User-Agent");
+        BEAST_EXPECT(str(hs, m) ==
+            "BREW / HTTP/1.0\r\n"
+            "Host: localhost\r\n"
+            "\r\n");
+        m.version = 20;
+        BEAST_EXPECT(str(hs, m) ==
+            "BREW / HTTP/2.0\r\n"
+            "Host: localhost\r\n"
+            "\r\n");
+    }
+
+    void
+    testResponse()
+    {
+        header_serializer hs;
+        response<empty_body> m;
+        m.status = 404;
+        m.reason = "Not Found";
+        m.version = 10;
+        m.headers.insert("Server", "test");
+        BEAST_EXPECT(str(hs, m) ==
+            "HTTP/1.0 404 Not Found\r\n"
+            "Server: test\r\n"
+            "\r\n");
+        m.status = 200;
+        m.reason = "";
+        m.version = 11;
+        m.headers.clear();
+        BEAST_EXPECT(str(hs, m) ==
+            "HTTP/1.1 200 \r\n"
+            "\r\n");
+        BEAST_EXPECT(hs.size() ==
+            header_serializer::serialized_size(m));
+    }
+
+    void
+    testStorage()
+    {
+        response<empty_body> m;
+        m.status = 200;
+        m.reason = "OK";
+        m.version = 11;
+        {
+            // Caller provided storage is used while it fits
+            char buf[64];
+            header_serializer hs(buf, sizeof(buf));
+            hs.serialize(m);
+            BEAST_EXPECT(hs.capacity() == sizeof(buf));
+            BEAST_EXPECT(boost::asio::buffer_cast<
+                char const*>(*hs.data().begin()) == buf);
+            m.headers.insert("Server", std::string(100, '*'));
+            hs.serialize(m);
+            BEAST_EXPECT(hs.capacity() == hs.size());
+            BEAST_EXPECT(boost::asio::buffer_cast<
+                char const*>(*hs.data().begin()) != buf);
+            m.headers.clear();
+        }
+        {
+            // Storage is kept for smaller messages
+            header_serializer hs;
+            BEAST_EXPECT(hs.capacity() == 0);
+            m.headers.insert("Server", "test");
+            hs.serialize(m);
+            auto const capacity = hs.capacity();
+            m.headers.clear();
+            hs.serialize(m);
+            BEAST_EXPECT(hs.capacity() == capacity);
+            BEAST_EXPECT(to_string(hs.data()) ==
+                "HTTP/1.1 200 OK\r\n\r\n");
+            hs.clear();
+            BEAST_EXPECT(hs.size() == 0);
+            BEAST_EXPECT(hs.capacity() == capacity);
+
+            header_serializer hs2(std::move(hs));
+            BEAST_EXPECT(hs.capacity() == 0);
+            BEAST_EXPECT(hs2.capacity() == capacity);
+        }
+    }
+
+    void
+    testStatusLine()
+    {
+        header_serializer hs;
+        response<empty_body> m;
+        m.version = 11;
+        for(int status = 100; status <= 599; ++status)
+        {
+            m.status = status;
+            m.reason = reason_string(status);
+            auto const s = str(hs, m);
+            BEAST_EXPECT(s == "HTTP/1.1 " +
+                std::to_string(status) + " " + m.reason + "\r\n\r\n");
+            BEAST_EXPECT(hs.size() ==
+                header_serializer::serialized_size(m));
+        }
+        // A reason which is not the standard one
+        m.status = 200;
+        m.reason = "Fine";
+        BEAST_EXPECT(str(hs, m) == "HTTP/1.1 200 Fine\r\n\r\n");
+        m.reason = "OKAY";
+        BEAST_EXPECT(str(hs, m) == "HTTP/1.1 200 OKAY\r\n\r\n");
+        m.reason = "O";
+        BEAST_EXPECT(str(hs, m) == "HTTP/1.1 200 O\r\n\r\n");
+        m.status = 1000;
+        m.reason = "OK";
+        BEAST_EXPECT(str(hs, m) == "HTTP/1.1 1000 OK\r\n\r\n");
+    }
+
+    void
+    testDate()
+    {
+        header_serializer hs;
+        BEAST_EXPECT(! hs.insert_date());
+        response<empty_body> res;
+        res.status = 200;
+        res.reason = "OK";
+        res.version = 11;
+        res.headers.insert("Server", "test");
+        hs.insert_date(true);
+        BEAST_EXPECT(hs.insert_date());
+        auto const s = str(hs, res);
+        BEAST_EXPECT(s.size() == hs.size());
+        BEAST_EXPECT(hs.size() ==
+            header_serializer::serialized_size(res) +
+                6 + date_size + 2);
+        BEAST_EXPECT(s.substr(0, 23) == "HTTP/1.1 200 OK\r\nDate: ");
+        BEAST_EXPECT(s.substr(19 + date_size) ==
+            " GMT\r\nServer: test\r\n\r\n");
+
+        // An existing Date field is kept
+        res.headers.insert("Date", "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(str(hs, res) ==
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+            "\r\n");
+
+        // Requests are unchanged
+        request<empty_body> req;
+        req.verb = verb::get;
+        req.url = "/";
+        req.version = 11;
+        BEAST_EXPECT(str(hs, req) == "GET / HTTP/1.1\r\n\r\n");
+
+        header_serializer hs2(std::move(hs));
+        BEAST_EXPECT(hs2.insert_date());
+    }
+
+    void run() override
+    {
+        testRequest();
+        testResponse();
+        testStorage();
+        testStatusLine();
+        testDate();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(header_serializer,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/write_dynabuf.hpp>
+#include <beast/test/timed_test.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class header_serializer_bench_test : public beast::unit_test::suite
+{
+public:
+    // Discards written data, counting the octets.
+    class null_write_stream
+    {
+    public:
+        std::size_t bytes = 0;
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers, error_code&)
+        {
+            auto const n = boost::asio::buffer_size(buffers);
+            bytes += n;
+            return n;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            return write_some(buffers, ec);
+        }
+    };
+
+    static std::size_t constexpr Responses = 1000000;
+
+    static
+    response<string_body>
+    build_response()
+    {
+        response<string_body> res;
+        res.version = 11;
+        res.status = 200;
+        res.reason = "OK";
+        res.headers.insert("Server", "header_serializer_bench");
+        res.headers.insert("Content-Type", "text/html");
+        res.headers.insert("Cache-Control", "no-cache");
+        res.body = "<html><body>Hello</body></html>";
+        prepare(res);
+        return res;
+    }
+
+    // Numeric fields as carried by cached or rate limited
+    // responses, replaced for every response written.
+    template<class Headers>
+    static
+    void
+    insert_numeric_fields(Headers& h, std::size_t i)
+    {
+        h.erase("Age");
+        h.erase("X-Request-Id");
+        h.erase("X-RateLimit-Remaining");
+        h.insert("Age", i % 3600);
+        h.insert("X-Request-Id", i);
+        h.insert("X-RateLimit-Remaining", 5000 - i % 5000);
+    }
+
+    // The headers are formatted into a streambuf,
+    // as write did before header_serializer.
+    static
+    void
+    streambuf_write(null_write_stream& s,
+        response<string_body> const& res)
+    {
+        streambuf sb;
+        beast::write(sb, "HTTP/");
+        beast::write(sb, res.version / 10);
+        beast::write(sb, ".");
+        beast::write(sb, res.version % 10);
+        beast::write(sb, " ");
+        beast::write(sb, res.status);
+        beast::write(sb, " ");
+        beast::write(sb, res.reason);
+        beast::write(sb, "\r\n");
+        for(auto const& field : res.headers)
+        {
+            beast::write(sb, field.name());
+            beast::write(sb, ": ");
+            beast::write(sb, field.value());
+            beast::write(sb, "\r\n");
+        }
+        beast::write(sb, "\r\n");
+        s.write_some(sb.data());
+        s.write_some(boost::asio::buffer(res.body));
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+
+        auto const res = build_response();
+        testcase << Responses << " responses";
+        std::size_t bytes = 0;
+        test::timed_test(log, Trials, "streambuf",
+            [&]
+            {
+                null_write_stream s;
+                for(std::size_t i = 0; i < Responses; ++i)
+                    streambuf_write(s, res);
+                bytes = s.bytes;
+            }, test::per_second{Responses, "responses"});
+        log << "bytes: " << bytes << std::endl;
+        test::timed_test(log, Trials, "write",
+            [&]
+            {
+                null_write_stream s;
+                for(std::size_t i = 0; i < Responses; ++i)
+                    beast::http::write(s, res);
+                bytes = s.bytes;
+            }, test::per_second{Responses, "responses"});
+        log << "bytes: " << bytes << std::endl;
+        test::timed_test(log, Trials, "write, reused header_serializer",
+            [&]
+            {
+                null_write_stream s;
+                header_serializer hs;
+                for(std::size_t i = 0; i < Responses; ++i)
+                    beast::http::write(s, res, hs);
+                bytes = s.bytes;
+            }, test::per_second{Responses, "responses"});
+        log << "bytes: " << bytes << std::endl;
+        test::timed_test(log, Trials, "write, reused header_serializer, Date",
+            [&]
+            {
+                null_write_stream s;
+                header_serializer hs;
+                hs.insert_date(true);
+                for(std::size_t i = 0; i < Responses; ++i)
+                    beast::http::write(s, res, hs);
+                bytes = s.bytes;
+            }, test::per_second{Responses, "responses"});
+        log << "bytes: " << bytes << std::endl;
+        pass();
+
+        auto res2 = res;
+        testcase << Responses << " responses, numeric fields";
+        test::timed_test(log, Trials, "streambuf",
+            [&]
+            {
+                null_write_stream s;
+                for(std::size_t i = 0; i < Responses; ++i)
+                {
+                    insert_numeric_fields(res2.headers, i);
+                    streambuf_write(s, res2);
+                }
+                bytes = s.bytes;
+            }, test::per_second{Responses, "responses"});
+        log << "bytes: " << bytes << std::endl;
+        test::timed_test(log, Trials, "write, reused header_serializer",
+            [&]
+            {
+                null_write_stream s;
+                header_serializer hs;
+                for(std::size_t i = 0; i < Responses; ++i)
+                {
+                    insert_numeric_fields(res2.headers, i);
+                    beast::http::write(s, res2, hs);
+                }
+                bytes = s.bytes;
+            }, test::per_second{Responses, "responses"});
+        log << "bytes: " << bytes << std::endl;
+        pass();
+    }
+
+    void run() override
+    {
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(header_serializer_bench,http,beast);
+
+} // http
+} // beast
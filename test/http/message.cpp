@@ -133,9 +133,12 @@ public:
         m1.url = "u";
         m1.body = "1";
         m1.headers.insert("h", "v");
+        m1.verb = verb::post;
         m2.method = "G";
         m2.body = "2";
         swap(m1, m2);
+        BEAST_EXPECT(m1.verb == verb::unknown);
+        BEAST_EXPECT(m2.verb == verb::post);
         BEAST_EXPECT(m1.method == "G");
         BEAST_EXPECT(m2.method.empty());
         BEAST_EXPECT(m1.url.empty());
@@ -47,6 +47,8 @@ public:
         check("http", parse_error::illegal_content_length);
         check("http", parse_error::invalid_chunk_size);
         check("http", parse_error::short_read);
+        check("http", parse_error::illegal_obs_fold);
+        check("http", parse_error::illegal_transfer_encoding);
         check("http", parse_error::general);
     }
 };
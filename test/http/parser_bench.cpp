@@ -11,8 +11,8 @@
 #include <beast/http.hpp>
 #include <beast/core/streambuf.hpp>
 #include <beast/core/to_string.hpp>
+#include <beast/test/timed_test.hpp>
 #include <beast/unit_test/suite.hpp>
-#include <chrono>
 #include <iostream>
 #include <vector>
 
@@ -79,29 +79,54 @@ public:
             }
     }
 
-    template<class Function>
-    void
-    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    template<bool isRequest, class Policy = parser_policy>
+    struct null_parser : basic_parser_v1<isRequest,
+        null_parser<isRequest, Policy>, Policy>
     {
-        using namespace std::chrono;
-        using clock_type = std::chrono::high_resolution_clock;
-        log << name << std::endl;
-        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        void on_start(error_code&) {}
+        void on_method(boost::string_ref const&, error_code&) {}
+        void on_uri(boost::string_ref const&, error_code&) {}
+        void on_reason(boost::string_ref const&, error_code&) {}
+        void on_request(error_code&) {}
+        void on_response(error_code&) {}
+        void on_field(boost::string_ref const&, error_code&) {}
+        void on_value(boost::string_ref const&, error_code&) {}
+        void on_headers(std::uint64_t, error_code&) {}
+        body_what on_body_what(std::uint64_t, error_code&)
         {
-            auto const t0 = clock_type::now();
-            f();
-            auto const elapsed = clock_type::now() - t0;
-            log <<
-                "Trial " << trial << ": " <<
-                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+            return body_what::normal;
         }
-    }
+        void on_body(boost::string_ref const&, error_code&) {}
+        void on_complete(error_code&) {}
+    };
 
-    template<bool isRequest>
-    struct null_parser : basic_parser_v1<isRequest, null_parser<isRequest>>
+    // No obs-fold, no chunked, no upgrade
+    struct strict_policy : parser_policy
     {
+        static bool constexpr obs_fold = false;
+        static bool constexpr chunked = false;
+        static bool constexpr upgrade = false;
     };
 
+    // Requests accepted by the strict parser
+    corpus
+    build_strict_corpus(std::size_t n)
+    {
+        corpus v;
+        message_fuzz mg;
+        while(v.size() < n)
+        {
+            streambuf sb;
+            mg.request(sb);
+            null_parser<true, strict_policy> p;
+            error_code ec;
+            p.write(sb.data(), ec);
+            if(! ec && p.complete())
+                v.emplace_back(std::move(sb));
+        }
+        return v;
+    }
+
     void
     testSpeed()
     {
@@ -118,7 +143,7 @@ public:
             ((Repeat * size_ + 512) / 1024) << "KB in " <<
                 (Repeat * (creq_.size() + cres_.size())) << " messages";
 
-        timedTest(Trials, "nodejs_parser",
+        test::timed_test(log, Trials, "nodejs_parser",
             [&]
             {
                 testParser<nodejs_parser<
@@ -128,7 +153,7 @@ public:
                     false, streambuf_body, headers>>(
                         Repeat, cres_);
             });
-        timedTest(Trials, "http::basic_parser_v1",
+        test::timed_test(log, Trials, "http::basic_parser_v1",
             [&]
             {
                 testParser<parser_v1<
@@ -141,10 +166,40 @@ public:
         pass();
     }
 
+    void
+    testPolicy()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 200;
+
+        auto const v = build_strict_corpus(N/2);
+        std::size_t size = 0;
+        for(auto const& sb : v)
+            size += sb.size();
+        testcase << "Parser policy speed test, " <<
+            ((Repeat * size + 512) / 1024) << "KB in " <<
+                (Repeat * v.size()) << " messages";
+
+        test::timed_test(log, Trials, "basic_parser_v1, parser_policy",
+            [&]
+            {
+                testParser<null_parser<
+                    true, parser_policy>>(Repeat, v);
+            });
+        test::timed_test(log, Trials, "basic_parser_v1, strict_policy",
+            [&]
+            {
+                testParser<null_parser<
+                    true, strict_policy>>(Repeat, v);
+            });
+        pass();
+    }
+
     void run() override
     {
         pass();
         testSpeed();
+        testPolicy();
     }
 };
 
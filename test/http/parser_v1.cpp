@@ -12,6 +12,7 @@
 #include <beast/http/headers.hpp>
 #include <beast/http/headers_parser_v1.hpp>
 #include <beast/http/parse.hpp>
+#include <beast/http/streambuf_body.hpp>
 #include <beast/http/string_body.hpp>
 #include <beast/test/string_stream.hpp>
 #include <beast/test/yield_to.hpp>
@@ -65,14 +66,14 @@ public:
         headers_parser_v1<true, headers> p0;
         parse(ss, rb, p0);
         request_headers<headers> const& reqh = p0.get();
-        BEAST_EXPECT(reqh.method == "GET");
+        BEAST_EXPECT(reqh.verb == verb::get);
         BEAST_EXPECT(reqh.url == "/");
         BEAST_EXPECT(reqh.version == 11);
         BEAST_EXPECT(reqh.headers["User-Agent"] == "test");
         BEAST_EXPECT(reqh.headers["Content-Length"] == "1");
         parser_v1<true, string_body, headers> p =
             with_body<string_body>(p0);
-        BEAST_EXPECT(p.get().method == "GET");
+        BEAST_EXPECT(p.get().verb == verb::get);
         BEAST_EXPECT(p.get().url == "/");
         BEAST_EXPECT(p.get().version == 11);
         BEAST_EXPECT(p.get().headers["User-Agent"] == "test");
@@ -82,6 +83,157 @@ public:
         BEAST_EXPECT(req.body == "*");
     }
 
+    void testFilter()
+    {
+        using boost::asio::buffer;
+        std::string const s =
+            "POST / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "User-Agent: test\r\n"
+            "Content-Length: 1\r\n"
+            "Accept: text/html,\r\n"
+            " text/plain\r\n"
+            "Cookie: x=1\r\n"
+            "\r\n"
+            "*";
+        auto const filter =
+            [](boost::string_ref const& name)
+            {
+                return name == "Host" || name == "Cookie";
+            };
+        // Feed one octet at a time
+        auto const parse =
+            [&](parser_v1<true, string_body, headers>& p)
+            {
+                error_code ec;
+                for(std::size_t i = 0; i < s.size();)
+                {
+                    i += p.write(buffer(&s[i], 1), ec);
+                    if(! BEAST_EXPECTS(! ec, ec.message()))
+                        break;
+                }
+                BEAST_EXPECT(p.complete());
+            };
+        {
+            parser_v1<true, string_body, headers> p;
+            p.set_option(header_filter{filter});
+            parse(p);
+            auto const& m = p.get();
+            BEAST_EXPECT(m.headers["Host"] == "localhost");
+            BEAST_EXPECT(m.headers["Cookie"] == "x=1");
+            BEAST_EXPECT(! m.headers.exists("User-Agent"));
+            BEAST_EXPECT(! m.headers.exists("Content-Length"));
+            BEAST_EXPECT(! m.headers.exists("Accept"));
+            BEAST_EXPECT(m.body == "*");
+            BEAST_EXPECT(p.filtered_fields().empty());
+        }
+        {
+            parser_v1<true, string_body, headers> p;
+            p.set_option(header_filter{filter});
+            p.set_option(capture_filtered{true});
+            parse(p);
+            auto const& m = p.get();
+            BEAST_EXPECT(m.headers["Host"] == "localhost");
+            BEAST_EXPECT(m.headers["Cookie"] == "x=1");
+            BEAST_EXPECT(m.body == "*");
+            BEAST_EXPECT(p.filtered_fields() ==
+                "User-Agent: test\r\n"
+                "Content-Length: 1\r\n"
+                "Accept: text/html, text/plain\r\n");
+        }
+    }
+
+    void testDirectBody()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::string const h =
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 10\r\n"
+            "\r\n";
+        {
+            parser_v1<true, string_body, headers> p;
+            error_code ec;
+            BEAST_EXPECT(p.write(buffer(h), ec) == h.size());
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.body_remaining() == 10);
+            BEAST_EXPECT(p.get().body.capacity() >= 10);
+            // partial fill, the rest of the storage is released
+            auto b = p.prepare_body(10);
+            BEAST_EXPECT(buffer_copy(b, buffer("0123", 4)) == 4);
+            p.commit_body(4, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.get().body == "0123");
+            BEAST_EXPECT(p.body_remaining() == 6);
+            BEAST_EXPECT(! p.complete());
+            // remaining octets through the parser
+            BEAST_EXPECT(p.write(buffer("45", 2), ec) == 2);
+            BEAST_EXPECT(p.body_remaining() == 4);
+            b = p.prepare_body(4);
+            buffer_copy(b, buffer("6789", 4));
+            p.commit_body(4, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.body_remaining() == 0);
+            BEAST_EXPECT(p.get().body == "0123456789");
+        }
+        {
+            parser_v1<true, string_body, headers> p;
+            p.set_option(body_max_size{5});
+            error_code ec;
+            p.write(buffer(h), ec);
+            BEAST_EXPECT(ec == parse_error::body_too_big);
+        }
+    }
+
+    // A large Content-Length does not by itself cause a
+    // large allocation, with or without a body limit.
+    void testHugeContentLength()
+    {
+        using boost::asio::buffer;
+        {
+            parser_v1<true, string_body, headers> p;
+            std::string const s =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 1000000000000000\r\n"
+                "\r\n";
+            error_code ec;
+            p.write(buffer(s), ec);
+            BEAST_EXPECT(ec == parse_error::body_too_big);
+            BEAST_EXPECT(p.get().body.capacity() < 65536);
+        }
+        {
+            parser_v1<false, string_body, headers> p;
+            std::string const s =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 1000000000000000\r\n"
+                "\r\n";
+            error_code ec;
+            BEAST_EXPECT(p.write(buffer(s), ec) == s.size());
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.body_remaining() == 1000000000000000ULL);
+            BEAST_EXPECT(p.get().body.capacity() <= 2 * 65536);
+            BEAST_EXPECT(p.write(buffer("*****", 5), ec) == 5);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.get().body == "*****");
+        }
+        {
+            parser_v1<false, streambuf_body, headers> p;
+            std::string const s =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 1000000000000000000\r\n"
+                "\r\n";
+            error_code ec;
+            BEAST_EXPECT(p.write(buffer(s), ec) == s.size());
+            BEAST_EXPECTS(! ec, ec.message());
+            auto const b = p.prepare_body(5);
+            boost::asio::buffer_copy(b, buffer("*****", 5));
+            p.commit_body(5, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.get().body.size() == 5);
+        }
+    }
+
     void run() override
     {
         using boost::asio::buffer;
@@ -99,7 +251,8 @@ public:
             BEAST_EXPECT(! ec);
             BEAST_EXPECT(p.complete());
             auto m = p.release();
-            BEAST_EXPECT(m.method == "GET");
+            BEAST_EXPECT(m.verb == verb::get);
+            BEAST_EXPECT(m.method.empty());
             BEAST_EXPECT(m.url == "/");
             BEAST_EXPECT(m.version == 11);
             BEAST_EXPECT(m.headers["User-Agent"] == "test");
@@ -125,6 +278,20 @@ public:
             BEAST_EXPECT(m.headers["Server"] == "test");
             BEAST_EXPECT(m.body == "*");
         }
+        // extension method
+        {
+            error_code ec;
+            parser_v1<true, string_body, headers> p;
+            std::string const s =
+                "BREW /pot HTTP/1.1\r\n"
+                "\r\n";
+            p.write(buffer(s), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+            auto m = p.release();
+            BEAST_EXPECT(m.verb == verb::unknown);
+            BEAST_EXPECT(m.method == "BREW");
+        }
         // skip body
         {
             error_code ec;
@@ -141,6 +308,9 @@ public:
 
         testRegressions();
         testWithBody();
+        testFilter();
+        testDirectBody();
+        testHugeContentLength();
     }
 };
 
@@ -0,0 +1,260 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/pipeline.hpp>
+
+#include <beast/http/headers.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/http/write.hpp>
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/test/string_stream.hpp>
+#include <beast/test/yield_to.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/lexical_cast.hpp>
+#include <string>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class pipeline_test
+    : public beast::unit_test::suite
+    , public test::enable_yield_to
+{
+public:
+    class string_write_stream
+    {
+        boost::asio::io_service& ios_;
+
+    public:
+        std::string str;
+        std::size_t writes = 0;
+
+        explicit
+        string_write_stream(boost::asio::io_service& ios)
+            : ios_(ios)
+        {
+        }
+
+        boost::asio::io_service&
+        get_io_service()
+        {
+            return ios_;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            auto const n = write_some(buffers, ec);
+            if(ec)
+                throw system_error{ec};
+            return n;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(
+            ConstBufferSequence const& buffers, error_code&)
+        {
+            using boost::asio::buffer_size;
+            using boost::asio::buffer_cast;
+            ++writes;
+            auto const n = buffer_size(buffers);
+            str.reserve(str.size() + n);
+            for(auto const& buffer : buffers)
+                str.append(buffer_cast<char const*>(buffer),
+                    buffer_size(buffer));
+            return n;
+        }
+
+        template<class ConstBufferSequence, class WriteHandler>
+        typename async_completion<
+            WriteHandler, void(error_code, std::size_t)>::result_type
+        async_write_some(ConstBufferSequence const& buffers,
+            WriteHandler&& handler)
+        {
+            error_code ec;
+            auto const bytes_transferred = write_some(buffers, ec);
+            async_completion<
+                WriteHandler, void(error_code, std::size_t)
+                    > completion(handler);
+            get_io_service().post(
+                bind_handler(completion.handler, ec, bytes_transferred));
+            return completion.result.get();
+        }
+    };
+
+    static
+    std::string
+    req(std::string const& url, bool close = false)
+    {
+        return
+            "GET " + url + " HTTP/1.1\r\n"
+            "Host: localhost\r\n" +
+            (close ? "Connection: close\r\n" : "") +
+            "Content-Length: 1\r\n"
+            "\r\n"
+            "*";
+    }
+
+    static
+    response<string_body>
+    res(std::string body, bool close = false)
+    {
+        response<string_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Server", "test");
+        m.body = std::move(body);
+        if(close)
+            prepare(m, connection::close);
+        else
+            prepare(m);
+        return m;
+    }
+
+    void
+    testReadBuffered()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        {
+            auto const s = req("/1") + req("/2") + req("/3").substr(0, 10);
+            streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(s.size()), buffer(s)));
+            std::vector<request<string_body>> v;
+            error_code ec;
+            BEAST_EXPECT(read_buffered(sb, v, ec) == 2);
+            BEAST_EXPECTS(! ec, ec.message());
+            if(BEAST_EXPECT(v.size() == 2))
+            {
+                BEAST_EXPECT(v[0].url == "/1");
+                BEAST_EXPECT(v[1].url == "/2");
+                BEAST_EXPECT(v[1].body == "*");
+            }
+            BEAST_EXPECT(to_string(sb.data()) ==
+                req("/3").substr(0, 10));
+        }
+        {
+            // Stop after Connection: close
+            auto const s = req("/1", true) + req("/2");
+            streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(s.size()), buffer(s)));
+            std::vector<request<string_body>> v;
+            error_code ec;
+            BEAST_EXPECT(read_buffered(sb, v, ec) == 1);
+            BEAST_EXPECT(sb.size() == req("/2").size());
+        }
+        {
+            // Invalid octets are left in the buffer
+            auto const s = req("/1") + "GET / X\r\n\r\n";
+            streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(s.size()), buffer(s)));
+            std::vector<request<string_body>> v;
+            error_code ec;
+            BEAST_EXPECT(read_buffered(sb, v, ec) == 1);
+            BEAST_EXPECT(ec);
+            BEAST_EXPECT(to_string(sb.data()) == "GET / X\r\n\r\n");
+        }
+        {
+            // Small elements, messages span buffers
+            auto const s = req("/1") + req("/2");
+            streambuf sb(7);
+            sb.commit(buffer_copy(sb.prepare(s.size()), buffer(s)));
+            std::vector<request<string_body>> v;
+            error_code ec;
+            BEAST_EXPECT(read_buffered(sb, v, ec) == 2);
+            BEAST_EXPECT(sb.size() == 0);
+        }
+    }
+
+    void
+    testReadPipelined(yield_context do_yield)
+    {
+        {
+            test::string_stream ss(ios_,
+                req("/1") + req("/2") + req("/3"));
+            streambuf sb;
+            std::vector<request<string_body>> v;
+            read_pipelined(ss, sb, v);
+            if(BEAST_EXPECT(v.size() == 3))
+                BEAST_EXPECT(v[2].url == "/3");
+            error_code ec;
+            read_pipelined(ss, sb, v, ec);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+        }
+        {
+            test::string_stream ss(ios_,
+                req("/1") + req("/2", true) + req("/3"));
+            streambuf sb;
+            std::vector<request<string_body>> v;
+            error_code ec;
+            async_read_pipelined(ss, sb, v, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(v.size() == 2);
+            BEAST_EXPECT(sb.size() == req("/3").size());
+        }
+    }
+
+    void
+    testWritePipelined(yield_context do_yield)
+    {
+        std::vector<response<string_body>> v;
+        v.push_back(res("1"));
+        v.push_back(res("22"));
+        v.push_back(res("333"));
+        std::string expected;
+        for(auto const& m : v)
+            expected += boost::lexical_cast<std::string>(m);
+        {
+            string_write_stream ws(ios_);
+            write_pipelined(ws, v);
+            BEAST_EXPECT(ws.str == expected);
+            BEAST_EXPECT(ws.writes == 1);
+        }
+        {
+            string_write_stream ws(ios_);
+            error_code ec;
+            async_write_pipelined(ws, v, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(ws.str == expected);
+            BEAST_EXPECT(ws.writes == 1);
+        }
+        {
+            // Messages after a close are not sent
+            v[1] = res("22", true);
+            string_write_stream ws(ios_);
+            error_code ec;
+            write_pipelined(ws, v, ec);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+            BEAST_EXPECT(ws.str ==
+                boost::lexical_cast<std::string>(v[0]) +
+                boost::lexical_cast<std::string>(v[1]));
+        }
+    }
+
+    void run() override
+    {
+        testReadBuffered();
+        yield_to(std::bind(&pipeline_test::testReadPipelined,
+            this, std::placeholders::_1));
+        yield_to(std::bind(&pipeline_test::testWritePipelined,
+            this, std::placeholders::_1));
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(pipeline,http,beast);
+
+} // http
+} // beast
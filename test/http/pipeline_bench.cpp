@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/test/timed_test.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class pipeline_bench_test : public beast::unit_test::suite
+{
+public:
+    // Reads from a string one segment at a time, so that
+    // each read returns at most one batch of requests.
+    // Written data is discarded and the writes are counted.
+    class stream
+    {
+        std::string const& s_;
+        std::size_t segment_;
+        std::size_t pos_ = 0;
+
+    public:
+        std::size_t writes = 0;
+
+        stream(std::string const& s, std::size_t segment)
+            : s_(s)
+            , segment_(segment)
+        {
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers,
+            error_code& ec)
+        {
+            auto const end = std::min(s_.size(),
+                (pos_ / segment_ + 1) * segment_);
+            auto const n = boost::asio::buffer_copy(buffers,
+                boost::asio::buffer(s_.data() + pos_, end - pos_));
+            pos_ += n;
+            if(n == 0)
+                ec = boost::asio::error::eof;
+            return n;
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers)
+        {
+            error_code ec;
+            auto const n = read_some(buffers, ec);
+            if(ec)
+                throw system_error{ec};
+            return n;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers, error_code&)
+        {
+            ++writes;
+            return boost::asio::buffer_size(buffers);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            return write_some(buffers, ec);
+        }
+    };
+
+    static
+    std::string
+    request_text()
+    {
+        return
+            "GET /index.html HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "User-Agent: pipeline_bench\r\n"
+            "Accept: */*\r\n"
+            "\r\n";
+    }
+
+    static
+    response<string_body>
+    build_response(request<string_body> const& req)
+    {
+        response<string_body> res;
+        res.version = req.version;
+        res.status = 200;
+        res.reason = "OK";
+        res.headers.insert("Server", "pipeline_bench");
+        res.headers.insert("Content-Type", "text/html");
+        res.body = "<html><body>Hello</body></html>";
+        prepare(res);
+        return res;
+    }
+
+    // One read and one write per request
+    std::size_t
+    serial(std::string const& input, std::size_t segment)
+    {
+        stream s(input, segment);
+        streambuf sb;
+        for(;;)
+        {
+            request<string_body> req;
+            error_code ec;
+            read(s, sb, req, ec);
+            if(ec)
+                break;
+            write(s, build_response(req), ec);
+            if(ec)
+                break;
+        }
+        return s.writes;
+    }
+
+    // One read and one write per batch of requests
+    std::size_t
+    pipelined(std::string const& input, std::size_t segment)
+    {
+        stream s(input, segment);
+        streambuf sb;
+        std::vector<request<string_body>> reqs;
+        std::vector<response<string_body>> res;
+        for(;;)
+        {
+            reqs.clear();
+            res.clear();
+            error_code ec;
+            read_pipelined(s, sb, reqs, ec);
+            if(ec)
+                break;
+            for(auto const& req : reqs)
+                res.emplace_back(build_response(req));
+            write_pipelined(s, res, ec);
+            if(ec)
+                break;
+        }
+        return s.writes;
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Requests = 64 * 1024;
+
+        std::string input;
+        for(std::size_t i = 0; i < Requests; ++i)
+            input += request_text();
+        for(std::size_t depth : {1, 2, 4, 8, 16, 32, 64})
+        {
+            auto const segment = depth * request_text().size();
+            testcase << "depth " << depth << ", " <<
+                Requests << " requests";
+            std::size_t writes = 0;
+            test::timed_test(log, Trials, "serial",
+                [&]
+                {
+                    writes = serial(input, segment);
+                });
+            log << "writes: " << writes << std::endl;
+            test::timed_test(log, Trials, "pipelined",
+                [&]
+                {
+                    writes = pipelined(input, segment);
+                });
+            log << "writes: " << writes << std::endl;
+            pass();
+        }
+    }
+
+    void run() override
+    {
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(pipeline_bench,http,beast);
+
+} // http
+} // beast
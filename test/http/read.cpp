@@ -12,6 +12,10 @@
 
 #include <beast/http/headers.hpp>
 #include <beast/http/streambuf_body.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/core/circular_streambuf.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/test/fail_stream.hpp>
 #include <beast/test/string_stream.hpp>
 #include <beast/test/yield_to.hpp>
@@ -329,6 +333,122 @@ public:
         }
     }
 
+    void testDirect(yield_context do_yield)
+    {
+        // Larger than one read, so that the
+        // body is read into the body storage.
+        std::string body;
+        for(std::size_t i = 0; i < 200000; ++i)
+            body.push_back("0123456789"[i % 10]);
+        auto const s =
+            "POST / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "\r\n" + body;
+        {
+            test::string_stream ss(ios_, s + "GET");
+            streambuf sb;
+            request<string_body> m;
+            read(ss, sb, m);
+            BEAST_EXPECT(m.body == body);
+            BEAST_EXPECT(to_string(sb.data()) == "");
+        }
+        {
+            test::string_stream ss(ios_, s);
+            streambuf sb;
+            request<streambuf_body> m;
+            read(ss, sb, m);
+            BEAST_EXPECT(to_string(m.body.data()) == body);
+        }
+        {
+            test::string_stream ss(ios_, s);
+            streambuf sb;
+            request<string_body> m;
+            error_code ec;
+            async_read(ss, sb, m, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m.body == body);
+        }
+        {
+            // Short read leaves no unused storage in the body
+            test::string_stream ss(ios_, s.substr(0, s.size() - 1000));
+            streambuf sb;
+            parser_v1<true, string_body, headers> p;
+            error_code ec;
+            parse(ss, sb, p, ec);
+            BEAST_EXPECT(ec == parse_error::short_read);
+            BEAST_EXPECT(p.get().body ==
+                body.substr(0, body.size() - 1000));
+        }
+        {
+            test::string_stream ss(ios_, s.substr(0, s.size() - 1000));
+            streambuf sb;
+            parser_v1<true, string_body, headers> p;
+            error_code ec;
+            async_parse(ss, sb, p, do_yield[ec]);
+            BEAST_EXPECT(ec == parse_error::short_read);
+            BEAST_EXPECT(p.get().body ==
+                body.substr(0, body.size() - 1000));
+        }
+    }
+
+    void testFlat(yield_context do_yield)
+    {
+        std::string const s =
+            "GET / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****";
+        {
+            test::string_stream ss(ios_, s + s);
+            flat_streambuf sb;
+            request<string_body> m;
+            read(ss, sb, m);
+            BEAST_EXPECT(m.body == "*****");
+            request<string_body> m2;
+            read(ss, sb, m2);
+            BEAST_EXPECT(m2.body == "*****");
+        }
+        {
+            test::string_stream ss(ios_, s);
+            flat_streambuf sb;
+            request<string_body> m;
+            error_code ec;
+            async_read(ss, sb, m, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m.body == "*****");
+        }
+    }
+
+    void testCircular(yield_context do_yield)
+    {
+        std::string const s =
+            "GET / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****";
+        std::string all;
+        for(int i = 0; i < 20; ++i)
+            all += s;
+        for(bool mirror : {true, false})
+        {
+            // The messages wrap around the end of the ring
+            test::string_stream ss(ios_, all);
+            circular_streambuf sb(100, mirror);
+            for(int i = 0; i < 20; ++i)
+            {
+                request<string_body> m;
+                error_code ec;
+                async_read(ss, sb, m, do_yield[ec]);
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    break;
+                BEAST_EXPECT(m.body == "*****");
+            }
+        }
+    }
+
     void run() override
     {
         testThrow();
@@ -341,6 +461,14 @@ public:
 
         yield_to(std::bind(&read_test::testEof,
             this, std::placeholders::_1));
+
+        yield_to(std::bind(&read_test::testDirect,
+            this, std::placeholders::_1));
+
+        yield_to(std::bind(&read_test::testFlat,
+            this, std::placeholders::_1));
+        yield_to(std::bind(&read_test::testCircular,
+            this, std::placeholders::_1));
     }
 };
 
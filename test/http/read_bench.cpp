@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "message_fuzz.hpp"
+
+#include <beast/http.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/test/timed_test.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class read_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr N = 2000;
+
+    // Reads from a string without erasing it, so
+    // that the stream itself costs little.
+    class corpus_stream
+    {
+        std::string const& s_;
+        std::size_t pos_ = 0;
+
+    public:
+        explicit
+        corpus_stream(std::string const& s)
+            : s_(s)
+        {
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers,
+            error_code& ec)
+        {
+            auto const n = boost::asio::buffer_copy(buffers,
+                boost::asio::buffer(s_.data() + pos_, s_.size() - pos_));
+            if(n == 0)
+                ec = boost::asio::error::eof;
+            pos_ += n;
+            return n;
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers)
+        {
+            error_code ec;
+            auto const n = read_some(buffers, ec);
+            if(ec)
+                throw system_error{ec};
+            return n;
+        }
+    };
+
+    // Pipelined requests, as read from one connection
+    static
+    std::string
+    build_corpus(std::size_t n)
+    {
+        std::string s;
+        message_fuzz mg;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            streambuf sb;
+            mg.request(sb);
+            s += to_string(sb.data());
+        }
+        return s;
+    }
+
+    template<class DynamicBuffer>
+    void
+    readAll(std::size_t repeat, std::string const& corpus)
+    {
+        while(repeat--)
+        {
+            corpus_stream ss(corpus);
+            DynamicBuffer db;
+            for(std::size_t i = 0; i < N; ++i)
+            {
+                request<string_body> m;
+                error_code ec;
+                read(ss, db, m, ec);
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    return;
+            }
+        }
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 50;
+
+        auto const corpus = build_corpus(N);
+        testcase << "Read speed test, " <<
+            ((Repeat * corpus.size() + 512) / 1024) << "KB in " <<
+                (Repeat * N) << " messages";
+        test::timed_test(log, Trials, "streambuf",
+            [&]
+            {
+                readAll<streambuf>(Repeat, corpus);
+            });
+        test::timed_test(log, Trials, "flat_streambuf",
+            [&]
+            {
+                readAll<flat_streambuf>(Repeat, corpus);
+            });
+        pass();
+    }
+
+    void run() override
+    {
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(read_bench,http,beast);
+
+} // http
+} // beast
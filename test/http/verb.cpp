@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/verb.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class verb_test : public unit_test::suite
+{
+public:
+    void
+    testRoundTrip()
+    {
+        for(int i = 1; i <= static_cast<int>(verb::unlink); ++i)
+        {
+            auto const v = static_cast<verb>(i);
+            auto const s = method_string(v);
+            BEAST_EXPECTS(! s.empty(), std::to_string(i));
+            BEAST_EXPECTS(string_to_verb(s) == v,
+                std::string(s.data(), s.size()));
+        }
+        BEAST_EXPECT(method_string(verb::unknown).empty());
+    }
+
+    void
+    testUnknown()
+    {
+        auto const bad =
+            [&](boost::string_ref const& s)
+            {
+                BEAST_EXPECTS(string_to_verb(s) == verb::unknown,
+                    std::string(s.data(), s.size()));
+            };
+        bad("");
+        bad("G");
+        bad("GE");
+        bad("get");
+        bad("GETS");
+        bad("BREW");
+        bad("PUSH");
+        bad("PATCHY");
+        bad("MSEARCH");
+        bad("UNBOUND");
+        bad("UNL");
+        bad("UNLOCKS");
+        bad("SUBSCRIBER");
+        bad("MKACTIVITYX");
+        bad("UNSUBSCRIBES");
+    }
+
+    void run() override
+    {
+        testRoundTrip();
+        testUnknown();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(verb,http,beast);
+
+} // http
+} // beast
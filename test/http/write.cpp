@@ -37,6 +37,7 @@ public:
 
     public:
         std::string str;
+        std::size_t writes = 0;
 
         explicit
         string_write_stream(boost::asio::io_service& ios)
@@ -69,6 +70,7 @@ public:
             auto const n = buffer_size(buffers);
             using boost::asio::buffer_size;
             using boost::asio::buffer_cast;
+            ++writes;
             str.reserve(str.size() + n);
             for(auto const& buffer : buffers)
                 str.append(buffer_cast<char const*>(buffer),
@@ -126,6 +128,78 @@ public:
         };
     };
 
+    // Provides the body one octet at a time, without suspending
+    struct octet_body
+    {
+        using value_type = std::string;
+
+        class writer
+        {
+            std::size_t n_ = 0;
+            value_type const& body_;
+
+        public:
+            template<bool isRequest, class Allocator>
+            explicit
+            writer(message<isRequest, octet_body, Allocator> const& msg) noexcept
+                : body_(msg.body)
+            {
+            }
+
+            void
+            init(error_code& ec) noexcept
+            {
+                beast::detail::ignore_unused(ec);
+            }
+
+            template<class WriteFunction>
+            bool
+            write(error_code&, WriteFunction&& wf) noexcept
+            {
+                if(n_ >= body_.size())
+                    return true;
+                wf(boost::asio::buffer(body_.data() + n_, 1));
+                ++n_;
+                return n_ == body_.size();
+            }
+        };
+    };
+
+    // Provides the whole body in one call to write,
+    // by calling the write function once per octet.
+    struct gather_body
+    {
+        using value_type = std::string;
+
+        class writer
+        {
+            value_type const& body_;
+
+        public:
+            template<bool isRequest, class Allocator>
+            explicit
+            writer(message<isRequest, gather_body, Allocator> const& msg) noexcept
+                : body_(msg.body)
+            {
+            }
+
+            void
+            init(error_code& ec) noexcept
+            {
+                beast::detail::ignore_unused(ec);
+            }
+
+            template<class WriteFunction>
+            bool
+            write(error_code&, WriteFunction&& wf) noexcept
+            {
+                for(std::size_t i = 0; i < body_.size(); ++i)
+                    wf(boost::asio::buffer(body_.data() + i, 1));
+                return true;
+            }
+        };
+    };
+
     struct fail_body
     {
         class writer;
@@ -599,6 +673,155 @@ public:
         }
     }
 
+    void
+    testSyncWriter(yield_context do_yield)
+    {
+        static_assert(detail::has_sync_write<
+            octet_body::writer>::value, "");
+        static_assert(! detail::has_sync_write<
+            unsized_body::writer>::value, "");
+        static_assert(detail::has_sync_write<
+            string_body::writer>::value, "");
+        message<false, octet_body, headers> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Server", "test");
+        m.headers.insert("Transfer-Encoding", "chunked");
+        m.body = "***";
+        auto const expected =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "1\r\n*\r\n"
+            "1\r\n*\r\n"
+            "1\r\n*\r\n"
+            "0\r\n\r\n";
+        {
+            // final chunk goes out with the last body chunk
+            string_write_stream ss(ios_);
+            write(ss, m);
+            BEAST_EXPECT(ss.str == expected);
+            BEAST_EXPECT(ss.writes == 3);
+        }
+        {
+            string_write_stream ss(ios_);
+            error_code ec;
+            async_write(ss, m, do_yield[ec]);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str == expected);
+            BEAST_EXPECT(ss.writes == 3);
+        }
+    }
+
+    void
+    testGather(yield_context do_yield)
+    {
+        message<false, gather_body, headers> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Server", "test");
+        m.headers.insert("Transfer-Encoding", "chunked");
+        // More buffers than the inline gather storage
+        m.body = std::string(12, '*');
+        auto const expected =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "c\r\n" + m.body + "\r\n"
+            "0\r\n\r\n";
+        {
+            string_write_stream ss(ios_);
+            write(ss, m);
+            BEAST_EXPECT(ss.str == expected);
+            BEAST_EXPECT(ss.writes == 1);
+        }
+        {
+            string_write_stream ss(ios_);
+            error_code ec;
+            async_write(ss, m, do_yield[ec]);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str == expected);
+            BEAST_EXPECT(ss.writes == 1);
+        }
+        {
+            // Empty chunked body
+            m.body = "";
+            string_write_stream ss(ios_);
+            write(ss, m);
+            BEAST_EXPECT(ss.str ==
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "0\r\n\r\n");
+            BEAST_EXPECT(ss.writes == 1);
+        }
+        {
+            m.headers.erase("Transfer-Encoding");
+            m.headers.insert("Content-Length", "3");
+            m.body = "***";
+            string_write_stream ss(ios_);
+            write(ss, m);
+            BEAST_EXPECT(ss.str ==
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n"
+                "***");
+            BEAST_EXPECT(ss.writes == 1);
+        }
+    }
+
+    void
+    testSerializer(yield_context do_yield)
+    {
+        message<false, string_body, headers> m1;
+        m1.version = 11;
+        m1.status = 200;
+        m1.reason = "OK";
+        m1.headers.insert("Server", "test");
+        m1.body = "*****";
+        prepare(m1);
+        auto m2 = m1;
+        m2.status = 404;
+        m2.reason = "Not Found";
+        m2.headers.insert("X-Padding", std::string(600, '-'));
+        auto const expected =
+            boost::lexical_cast<std::string>(m1) +
+            boost::lexical_cast<std::string>(m2);
+        {
+            header_serializer hs;
+            string_write_stream ss(ios_);
+            write(ss, m1, hs);
+            write(ss, m2, hs);
+            BEAST_EXPECT(ss.str == expected);
+            auto const capacity = hs.capacity();
+            write(ss, m1, hs);
+            BEAST_EXPECT(hs.capacity() == capacity);
+        }
+        {
+            header_serializer hs;
+            string_write_stream ss(ios_);
+            error_code ec;
+            async_write(ss, m1, hs, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            async_write(ss, m2, hs, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(ss.str == expected);
+        }
+        {
+            // Default write path, headers larger than inline storage
+            string_write_stream ss(ios_);
+            write(ss, m2);
+            BEAST_EXPECT(ss.str ==
+                boost::lexical_cast<std::string>(m2));
+        }
+    }
+
     void testConvert()
     {
         message<true, string_body, headers> m;
@@ -612,6 +835,23 @@ public:
             "GET / HTTP/1.1\r\nUser-Agent: test\r\nContent-Length: 1\r\n\r\n*");
     }
 
+    void testVerb()
+    {
+        message<true, string_body, headers> m;
+        m.verb = verb::post;
+        m.method = "IGNORED";
+        m.url = "/";
+        m.version = 11;
+        m.body = "*";
+        prepare(m);
+        BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+            "POST / HTTP/1.1\r\nContent-Length: 1\r\n\r\n*");
+        m.verb = verb::unknown;
+        m.method = "BREW";
+        BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+            "BREW / HTTP/1.1\r\nContent-Length: 1\r\n\r\n*");
+    }
+
     void testOstream()
     {
         message<true, string_body, headers> m;
@@ -642,7 +882,14 @@ public:
         yield_to(std::bind(&write_test::testFailures,
             this, std::placeholders::_1));
         testOutput();
+        yield_to(std::bind(&write_test::testSyncWriter,
+            this, std::placeholders::_1));
+        yield_to(std::bind(&write_test::testGather,
+            this, std::placeholders::_1));
+        yield_to(std::bind(&write_test::testSerializer,
+            this, std::placeholders::_1));
         testConvert();
+        testVerb();
         testOstream();
     }
 };
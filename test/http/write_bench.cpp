@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http.hpp>
+#include <beast/core/detail/type_traits.hpp>
+#include <beast/test/timed_test.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class write_bench_test : public beast::unit_test::suite
+{
+public:
+    // Discards written data, counting the octets.
+    class null_write_stream
+    {
+    public:
+        std::size_t bytes = 0;
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers, error_code&)
+        {
+            auto const n = boost::asio::buffer_size(buffers);
+            bytes += n;
+            return n;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            return write_some(buffers, ec);
+        }
+    };
+
+    // Same as string_body, but the writer accepts a resume
+    // context, so the implementation must be prepared for
+    // the writer to suspend.
+    struct resumable_string_body
+    {
+        using value_type = std::string;
+
+        class writer
+        {
+            value_type const& body_;
+
+        public:
+            template<bool isRequest, class Headers>
+            explicit
+            writer(message<isRequest,
+                resumable_string_body, Headers> const& msg) noexcept
+                : body_(msg.body)
+            {
+            }
+
+            void
+            init(error_code& ec) noexcept
+            {
+                beast::detail::ignore_unused(ec);
+            }
+
+            std::uint64_t
+            content_length() const noexcept
+            {
+                return body_.size();
+            }
+
+            template<class WriteFunction>
+            boost::tribool
+            write(resume_context&&, error_code&,
+                WriteFunction&& wf) noexcept
+            {
+                wf(boost::asio::buffer(body_));
+                return true;
+            }
+        };
+    };
+
+    static std::size_t constexpr Responses = 1000000;
+
+    template<class Body>
+    static
+    response<Body>
+    build_response()
+    {
+        response<Body> res;
+        res.version = 11;
+        res.status = 200;
+        res.reason = "OK";
+        res.headers.insert("Server", "write_bench");
+        res.headers.insert("Content-Type", "text/plain");
+        res.body = "Hello, world!";
+        prepare(res);
+        return res;
+    }
+
+    template<class Body>
+    void
+    testBody(std::string const& name)
+    {
+        static std::size_t constexpr Trials = 3;
+
+        auto const res = build_response<Body>();
+        std::size_t bytes = 0;
+        test::timed_test(log, Trials, name,
+            [&]
+            {
+                null_write_stream s;
+                header_serializer hs;
+                for(std::size_t i = 0; i < Responses; ++i)
+                    beast::http::write(s, res, hs);
+                bytes = s.bytes;
+            }, test::per_second{Responses, "responses"});
+        log << "bytes: " << bytes << std::endl;
+    }
+
+    void
+    testSpeed()
+    {
+        testcase << Responses << " small responses";
+        testBody<resumable_string_body>("resumable writer");
+        testBody<string_body>("synchronous writer");
+        pass();
+    }
+
+    void run() override
+    {
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(write_bench,http,beast);
+
+} // http
+} // beast
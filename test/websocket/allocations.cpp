@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/websocket/stream.hpp>
+#include <beast/http/empty_body.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/test/counting_allocator.hpp>
+#include <beast/test/fail_stream.hpp>
+#include <beast/test/string_stream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+#include <string>
+
+namespace beast {
+namespace websocket {
+
+class allocations_test : public beast::unit_test::suite
+{
+public:
+    using counting_streambuf = basic_streambuf<
+        test::counting_allocator<char>>;
+
+    // Number of messages in each loop
+    static std::size_t constexpr N = 100;
+
+    // The payload of each message
+    static std::size_t constexpr Size = 16;
+
+    static
+    http::request<http::empty_body>
+    upgrade_request()
+    {
+        http::request<http::empty_body> req;
+        req.method = "GET";
+        req.url = "/";
+        req.version = 11;
+        req.headers.insert("Host", "localhost:80");
+        req.headers.insert("Upgrade", "websocket");
+        req.headers.insert("Connection", "upgrade");
+        req.headers.insert("Sec-WebSocket-Key",
+            "dGhlIHNhbXBsZSBub25jZQ==");
+        req.headers.insert("Sec-WebSocket-Version", "13");
+        return req;
+    }
+
+    // N masked binary frames, as sent by a client. The
+    // mask key is zero, so the payload appears as-is.
+    static
+    std::string
+    client_frames()
+    {
+        std::string s;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            s.push_back('\x82');
+            s.push_back(static_cast<char>(0x80 | Size));
+            s.append(4, '\0');
+            s.append(Size, '*');
+        }
+        return s;
+    }
+
+    // Once the buffer holds a message, reading the next one
+    // does not allocate from it. The asynchronous read allocates
+    // a fixed number of times per message, and frees everything
+    // before the upcall.
+    void
+    testRead()
+    {
+        boost::asio::io_service ios;
+        test::allocation_counter c;
+        stream<test::string_stream> ws(ios, client_frames());
+        ws.accept(upgrade_request());
+        counting_streambuf sb(1024,
+            test::counting_allocator<char>(c));
+        for(std::size_t i = 0; i < N / 2; ++i)
+        {
+            c.reset();
+            opcode op;
+            ws.read(op, sb);
+            BEAST_EXPECT(op == opcode::binary);
+            BEAST_EXPECT(to_string(sb.data()) ==
+                std::string(Size, '*'));
+            if(i > 0)
+                BEAST_EXPECT(c.allocations == 0);
+            sb.consume(sb.size());
+        }
+        test::allocation_counter hc;
+        std::size_t peak = 0;
+        for(std::size_t i = N / 2; i < N; ++i)
+        {
+            c.reset();
+            hc.reset();
+            opcode op;
+            error_code result = boost::asio::error::fault;
+            ws.async_read(op, sb, test::bind_counter(hc,
+                [&](error_code const& ec)
+                {
+                    BEAST_EXPECT(hc.live == 0);
+                    result = ec;
+                }));
+            ios.run();
+            ios.reset();
+            BEAST_EXPECTS(! result, result.message());
+            BEAST_EXPECT(sb.size() == Size);
+            BEAST_EXPECT(c.allocations == 0);
+            BEAST_EXPECT(hc.allocations <= 8);
+            BEAST_EXPECT(hc.deallocations == hc.allocations);
+            if(i == N / 2)
+                peak = hc.peak;
+            else
+                BEAST_EXPECT(hc.peak == peak);
+            sb.consume(sb.size());
+        }
+    }
+
+    // The asynchronous write allocates a fixed number
+    // of times per message.
+    void
+    testWrite()
+    {
+        boost::asio::io_service ios;
+        stream<test::fail_stream<test::string_stream>> ws(
+            4 * N, ios, "");
+        ws.accept(upgrade_request());
+        std::string const s(Size, '*');
+        test::allocation_counter hc;
+        std::size_t peak = 0;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            ws.write(boost::asio::buffer(s));
+            hc.reset();
+            error_code result = boost::asio::error::fault;
+            ws.async_write(boost::asio::buffer(s),
+                test::bind_counter(hc,
+                    [&](error_code const& ec)
+                    {
+                        BEAST_EXPECT(hc.live == 0);
+                        result = ec;
+                    }));
+            ios.run();
+            ios.reset();
+            BEAST_EXPECTS(! result, result.message());
+            BEAST_EXPECT(hc.allocations <= 3);
+            BEAST_EXPECT(hc.deallocations == hc.allocations);
+            if(i == 0)
+                peak = hc.peak;
+            else
+                BEAST_EXPECT(hc.peak == peak);
+        }
+    }
+
+    void
+    run() override
+    {
+        testRead();
+        testWrite();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(allocations,websocket,beast);
+
+} // websocket
+} // beast